@@ -0,0 +1,30 @@
+#ifndef CLI_HPP
+#define CLI_HPP
+#include <string>
+#include <cmath>
+#include <limits>
+
+/*────────────────────  Command-line numbers  ────────────────────*/
+/* The whole token must be a number: "x", "12abc", "" and, for counts, any
+   sign are rejected instead of throwing or wrapping ("-1" would otherwise
+   become SIZE_MAX). Counts must also be >= min, reals finite.          */
+template<class U> inline bool parse_count(const std::string& s,U& out,U min=1){
+    if(s.empty()||s.find_first_not_of("0123456789")!=std::string::npos) return false;
+    try{
+        unsigned long long v=std::stoull(s);
+        if(v>std::numeric_limits<U>::max()||v<min) return false;
+        out=static_cast<U>(v);
+    } catch(...){ return false; }
+    return true;
+}
+
+inline bool parse_real(const std::string& s,double& out){
+    try{
+        size_t used=0; double v=std::stod(s,&used);
+        if(used!=s.size()||!std::isfinite(v)) return false;
+        out=v;
+    } catch(...){ return false; }
+    return true;
+}
+
+#endif
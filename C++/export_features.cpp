@@ -1,104 +1,299 @@
-#include "indicators.hpp"
+#include "features.hpp"
+#include "stream.hpp"
+#include "feature_cache.hpp"
+#include "window.hpp"
+#include "cli.hpp"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <iomanip>
 #include <iostream>
-#include <algorithm>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
 
-static bool to_double(std::string tok, double &out) {
-    tok.erase(std::remove(tok.begin(), tok.end(), '"'), tok.end());
-    try { out = std::stod(tok); } catch(...) { return false; }
-    return true;
+struct Options {
+    bool f32 = false;
+    unsigned scan = 1;                 // --scan-threads
+    size_t chunk = 0;                  // rows per chunk, 0 = in-memory export
+    std::vector<std::string> names = feature_names();
+    FeatureParams params;
+    std::string cache_dir;             // empty = no cache
+    size_t window = 0;                 // look-back rows, 0 = no window export
+    std::string scaler;                // feature,mean,scale CSV for the windows
+};
+
+// Writes row i of F; supertrend_signal is printed as 0/1.
+template<class T>
+static void write_row(std::ostream& out, const std::string& date,
+                      const FeatureSet<T>& F, size_t i) {
+    out << date;
+    for(size_t j=0; j<F.cols.size(); ++j) {
+        if(F.names[j] == "supertrend_signal") out << ',' << static_cast<int>(F.cols[j][i]);
+        else out << ',' << F.cols[j][i];
+    }
+    out << '\n';
+}
+
+static void write_header(std::ostream& out, const std::vector<std::string>& names) {
+    out << "date";
+    for(const auto& name : names) out << ',' << name;
+    out << '\n' << std::fixed << std::setprecision(6);
 }
 
-// New: Volume-weighted features
-std::vector<double> volume_weighted_rsi(const std::vector<double>& prices,
-                                      const std::vector<double>& volumes,
-                                      int period=14) {
-    auto rsi_val = rsi(prices, period);
-    double min_vol = *std::min_element(volumes.begin(), volumes.end());
-    double vol_range = *std::max_element(volumes.begin(), volumes.end()) - min_vol;
-    
-    for(size_t i=0; i<rsi_val.size(); ++i) {
-        if(!is_nan(rsi_val[i]) && !is_nan(volumes[i])) {
-            double vol_norm = (volumes[i] - min_vol) / vol_range;
-            double vol_scale = 0.8 + 0.4 * vol_norm;
-            rsi_val[i] = 50 + (rsi_val[i]-50)*vol_scale;
+/* Window export: the exported rows as one contiguous float32 N×F matrix
+   (<stem>.X.npy, row i = CSV data row i) plus each W-row window of
+   consecutive bars as a row range [start, end) into it (<stem>.win.npy,
+   int64 K×2). The windows are offsets, never copies; python/windows.py
+   turns them into views without materializing anything.               */
+template<class T>
+static bool export_windows(const std::string& out, const FeatureSet<T>& F, const Options& opt) {
+    auto M = FeatureMatrix<float>::from(F);
+    if(!opt.scaler.empty()) {
+        Scaler<float> sc;
+        if(!sc.load(opt.scaler, F.names)) {
+            std::cerr << "Cannot read scaler for every exported column from " << opt.scaler << '\n';
+            return false;
         }
+        for(size_t i=0; i<M.rows; ++i) sc.apply(M.row(i), M.row(i), M.cols);
+    }
+    WindowView<float> v(M, opt.window);
+    std::vector<int64_t> win(2 * v.size());
+    for(size_t i=0; i<v.size(); ++i) { win[2*i] = v.start(i); win[2*i+1] = v.start(i) + opt.window; }
+
+    std::string stem = std::filesystem::path(out).replace_extension().string();
+    if(!write_npy(stem + ".X.npy", M.data.data(), {M.rows, M.cols}) ||
+       !write_npy(stem + ".win.npy", win.data(), {v.size(), 2})) {
+        std::cerr << "Cannot write " << stem << ".X.npy / .win.npy\n";
+        return false;
     }
-    return rsi_val;
+    size_t spanning = (M.rows >= opt.window ? M.rows - opt.window + 1 : 0) - v.size();
+    std::cout << "Windows     : " << v.size() << " x (" << opt.window << ", " << M.cols
+              << ") over a " << M.rows << " x " << M.cols << " matrix"
+              << (opt.scaler.empty() ? "" : ", scaled") << '\n';
+    if(spanning) std::cout << "              " << spanning << " skipped across dropped rows\n";
+    return true;
 }
 
-int main(int argc, char* argv[]) {
-    if(argc != 3) { std::cerr << "Usage: export_features.exe <raw> <out>\n"; return 1; }
-    
-    // Data loading (unchanged)
-    std::ifstream fin(argv[1]);
-    if(!fin) { std::cerr << "Cannot open " << argv[1] << '\n'; return 1; }
-
-    std::vector<std::string> date; 
-    std::vector<double> o, h, l, c, adj, v;
-    std::string line; 
-    
-    std::getline(fin, line); // header
-    while(std::getline(fin, line)) {
-        std::stringstream ss(line); 
-        std::string d, tok; 
-        double tmp;
-        
-        if(!std::getline(ss, d, ',')) continue;
-        date.push_back(d.substr(0,10));
-        
-        // Parse OHLCVA data
-        if(!std::getline(ss, tok, ',') || !to_double(tok, tmp)) continue; o.push_back(tmp);
-        if(!std::getline(ss, tok, ',') || !to_double(tok, tmp)) continue; h.push_back(tmp);
-        if(!std::getline(ss, tok, ',') || !to_double(tok, tmp)) continue; l.push_back(tmp);
-        if(!std::getline(ss, tok, ',') || !to_double(tok, tmp)) continue; c.push_back(tmp);
-        if(!std::getline(ss, tok, ',') || !to_double(tok, tmp)) continue; adj.push_back(tmp);
-        std::getline(ss, tok); to_double(tok, tmp); v.push_back(tmp);
+/* Full cache hit: every selected column plus the dates are on disk, so
+   the raw file is neither parsed nor computed on.                      */
+template<class T>
+static bool load_cached(FeatureCache<T>& cache, const Options& opt,
+                        std::vector<std::string>& date, FeatureSet<T>& F) {
+    if(!cache.load_dates(date)) return false;
+    OHLCV<T> none;    // signatures don't depend on the data
+    auto g = build_feature_graph(none, opt.params, opt.scan);
+    F.names = opt.names; F.cols.assign(opt.names.size(), {});
+    for(size_t j=0; j<opt.names.size(); ++j)
+        if(!cache.load(g.signature(opt.names[j]), F.cols[j]) || F.cols[j].size() != date.size()
+           || F.cols[j].size() != F.cols[0].size())
+            return false;
+    return true;
+}
+
+template<class T>
+static int export_features(const std::string& raw, const std::string& out, const Options& opt) {
+    std::unique_ptr<FeatureCache<T>> cache;
+    std::vector<std::string> date;
+    FeatureSet<T> F;
+    bool hit = false;
+    if(!opt.cache_dir.empty()) {
+        uint64_t h;
+        if(!hash_file(raw, h)) { std::cerr << "Cannot open " << raw << '\n'; return 1; }
+        // scan results depend on where the chunks are cut, i.e. on the thread count
+        unsigned threads = opt.scan ? opt.scan : std::max(1u, std::thread::hardware_concurrency());
+        std::string tag = std::string(sizeof(T) == 4 ? "f32" : "f64")
+                        + (opt.scan != 1 ? "-scan" + std::to_string(threads) : "");
+        cache = std::make_unique<FeatureCache<T>>(opt.cache_dir, h, tag);
+        hit = load_cached(*cache, opt, date, F);
+        cache->hits = cache->misses = 0;
     }
+    if(!hit) {
+        OHLCV<T> d;
+        if(!load_ohlcv(raw, d)) { std::cerr << "Cannot open " << raw << '\n'; return 1; }
 
-    // Calculate indicators
-    size_t n = c.size();
-    auto M = macd(c);
-    auto R = volume_weighted_rsi(c, v); // Modified: Volume-weighted RSI
-    auto ST = supertrend(h, l, c);
-    auto BB = boll_percent(c);
-    auto S = stoch(h, l, c);
-    auto ATR = atr(h, l, c);
-    auto ROC = roc(c);
-    auto OBV = obv(c, v);
-    
-    // New: VWAP indicator
-    std::vector<double> vwap(n);
-    for(size_t i=0; i<n; ++i) {
-        vwap[i] = (h[i] + l[i] + c[i])/3 * v[i];
+        // Calculate only the selected indicators (reusing cached columns)
+        F = compute_features(d, opt.names, true, opt.scan, opt.params, cache.get());
+        date = std::move(d.date);
+        if(cache) cache->store_dates(date);
     }
+    size_t n = F.rows();
 
     // Write features
-    std::ofstream fout(argv[2]);
-    if(!fout) { std::cerr << "Cannot write " << argv[2] << '\n'; return 1; }
-    
-    fout << "date,close,macd_hist,rsi,supertrend_signal,"
-            "bb_percent,stoch_k,stoch_d,atr_pct,roc,obv,vwap\n";
-    
+    std::ofstream fout(out);
+    if(!fout) { std::cerr << "Cannot write " << out << '\n'; return 1; }
+
+    write_header(fout, F.names);
+
     size_t kept = 0;
     for(size_t i=0; i<n; ++i) {
-        if(is_nan(M.hist[i]) || is_nan(R[i]) || is_nan(ST[i]) || 
-           is_nan(BB[i]) || is_nan(S.k[i]) || is_nan(S.d[i]) || 
-           is_nan(ATR[i]) || is_nan(ROC[i]) || is_nan(OBV[i]) || is_nan(vwap[i]))
-            continue;
-            
-        fout << date[i] << ',' << std::fixed << std::setprecision(6) << c[i] << ','
-             << M.hist[i] << ',' << R[i] << ',' << (c[i] > ST[i]) << ','
-             << BB[i] << ',' << S.k[i] << ',' << S.d[i] << ',' << (ATR[i]/c[i]) << ','
-             << ROC[i] << ',' << OBV[i] << ',' << vwap[i] << '\n';
+        if(!row_complete(F, i)) continue;
+        write_row(fout, date[i], F, i);
         ++kept;
     }
 
+    std::cout << (hit ? "Cached rows : " : "Parsed rows : ") << n
+              << "\nExported    : " << kept << "\n";
+    if(opt.window && !export_windows(out, F, opt)) return 1;
+    if(hit) std::cout << "Cache       : hit, computation skipped\n";
+    else if(cache) std::cout << "Cache       : " << cache->hits << " column(s) reused, "
+                             << cache->misses << " computed\n";
+    std::cout << "✓ Features written to " << out << '\n';
+    return 0;
+}
+
+/* Streaming mode: the input is read `chunk` rows at a time and the
+   indicator state is carried across chunks by FeatureStream. Reading,
+   computing and writing run on three threads joined by double buffers, so
+   at most four chunks are in memory whatever the file size.             */
+template<class T>
+struct FeatureChunk { std::vector<std::string> date; FeatureSet<T> F; };
+
+template<class T>
+static int export_stream(const std::string& raw, const std::string& out, const Options& opt) {
+    const auto& names = opt.names;
+    size_t chunk = opt.chunk;
+    T vmin = 0, vrange = 0;
+    bool need_vol = std::find(names.begin(), names.end(), "rsi") != names.end();
+    std::ifstream fin(raw);
+    if(!fin || (need_vol && !volume_range(raw, vmin, vrange))) {
+        std::cerr << "Cannot open " << raw << '\n'; return 1;
+    }
+    std::ofstream fout(out);
+    if(!fout) { std::cerr << "Cannot write " << out << '\n'; return 1; }
+    write_header(fout, names);
+
+    DoubleBuffer<OHLCV<T>> raw_q;
+    DoubleBuffer<FeatureChunk<T>> feat_q;
+    size_t n = 0, kept = 0;
+
+    std::thread reader([&] {
+        std::string line;
+        std::getline(fin, line); // header
+        bool more = true;
+        while(more) {
+            auto& b = raw_q.acquire();
+            b.clear();
+            while(b.size() < chunk && (more = static_cast<bool>(std::getline(fin, line))))
+                parse_row(line, b);
+            n += b.size();
+            raw_q.publish(!more);
+        }
+    });
+    std::thread compute([&] {
+        FeatureStream<T> fs(names, vmin, vrange, opt.params);
+        bool last = false;
+        while(!last) {
+            auto& in = raw_q.next(last);
+            auto& o = feat_q.acquire();
+            fs.process(in, o.F);
+            o.date.assign(in.date.begin(), in.date.end());
+            raw_q.release();
+            feat_q.publish(last);
+        }
+    });
+
+    bool last = false;
+    while(!last) {
+        auto& o = feat_q.next(last);
+        for(size_t i=0; i<o.F.rows(); ++i) {
+            if(!row_complete(o.F, i)) continue;
+            write_row(fout, o.date[i], o.F, i);
+            ++kept;
+        }
+        feat_q.release();
+    }
+    reader.join(); compute.join();
+
     std::cout << "Parsed rows : " << n << "\nExported    : " << kept << "\n"
-              << "✓ Features written to " << argv[2] << '\n';
+              << "✓ Features written to " << out << '\n';
     return 0;
-}
\ No newline at end of file
+}
+
+// Parses a --features list into distinct exported columns in file order.
+static bool select_features(const std::string& list, std::vector<std::string>& names) {
+    std::vector<std::string> asked;
+    std::stringstream ss(list); std::string tok;
+    while(std::getline(ss, tok, ',')) {
+        if(tok.empty()) continue;
+        const auto& all = feature_names();
+        if(std::find(all.begin(), all.end(), tok) == all.end()) {
+            std::cerr << "Unknown feature '" << tok << "'. Available:";
+            for(const auto& f : all) std::cerr << ' ' << f;
+            std::cerr << '\n';
+            return false;
+        }
+        asked.push_back(tok);
+    }
+    names.clear();
+    for(const auto& f : feature_names())
+        if(std::find(asked.begin(), asked.end(), f) != asked.end()) names.push_back(f);
+    return !names.empty();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    std::vector<std::string> pos;
+    auto bad = [&](const std::string& flag, const char* val) {
+        std::cerr << "Bad value '" << val << "' for " << flag << '\n'; return 1;
+    };
+    for(int i=1; i<argc; ++i) {
+        std::string a = argv[i];
+        if(a == "--f32") opt.f32 = true;
+        else if(a == "--features" && i+1 < argc) {
+            if(!select_features(argv[++i], opt.names)) return 1;
+        }
+        else if(a == "--param" && i+1 < argc) {
+            if(!opt.params.set(argv[++i])) { std::cerr << "Bad parameter '" << argv[i] << "'\n"; return 1; }
+        }
+        else if(a == "--scan-threads" && i+1 < argc) {
+            if(!parse_count(argv[++i], opt.scan, 0u)) return bad(a, argv[i]);
+        }
+        else if(a == "--stream") opt.chunk = 1u << 16;
+        else if(a == "--chunk" && i+1 < argc) {
+            if(!parse_count(argv[++i], opt.chunk)) return bad(a, argv[i]);
+        }
+        else if(a == "--cache" && i+1 < argc) opt.cache_dir = argv[++i];
+        else if(a == "--windows" && i+1 < argc) {
+            if(!parse_count(argv[++i], opt.window)) return bad(a, argv[i]);
+        }
+        else if(a == "--scaler" && i+1 < argc) opt.scaler = argv[++i];
+        else pos.push_back(a);
+    }
+    if(pos.size() != 2 || (opt.chunk && (opt.scan != 1 || !opt.cache_dir.empty() || opt.window))
+       || (!opt.scaler.empty() && !opt.window)) {
+        std::cerr << "Usage: export_features.exe [--f32] [--features a,b,...] [--param name=value]...\n"
+                     "                           [--scan-threads N] [--cache DIR]\n"
+                     "                           [--windows W [--scaler CSV]]\n"
+                     "                           [--stream | --chunk ROWS] <raw> <out>\n"
+                     "  --f32       compute every indicator in float32 instead of double\n"
+                     "  --features  export only these columns (default: all); only the\n"
+                     "              indicators they depend on are computed\n"
+                     "  --param     override an indicator parameter, e.g. rsi_period=7\n"
+                     "              (macd_fast/slow/signal, rsi_period, st_period, st_mult,\n"
+                     "              atr_period, bb_period, bb_k, stoch_k, stoch_d, roc_period)\n"
+                     "  --scan-threads  evaluate EMA/RSI/OBV as a parallel prefix scan on N\n"
+                     "              threads (0 = all cores; default 1 = sequential), at most\n"
+                     "              one per 4096 rows\n"
+                     "  --cache     reuse columns computed earlier for the same input bytes\n"
+                     "              and parameters from DIR; a full hit skips computation\n"
+                     "  --windows   also write <out>.X.npy (float32 feature matrix) and\n"
+                     "              <out>.win.npy (row ranges of every W-row window of\n"
+                     "              consecutive bars)\n"
+                     "  --scaler    standardize the matrix with a feature,mean,scale CSV\n"
+                     "  --stream    read/compute/write in 65536-row chunks on three threads,\n"
+                     "              memory bounded by the chunk size (not with --scan-threads,\n"
+                     "              --cache or --windows); with rsi selected, the volume column\n"
+                     "              is read in one extra pass first for its range\n"
+                     "  --chunk     like --stream with ROWS rows per chunk\n";
+        return 1;
+    }
+    if(opt.chunk)
+        return opt.f32 ? export_stream<float>(pos[0], pos[1], opt)
+                       : export_stream<double>(pos[0], pos[1], opt);
+    return opt.f32 ? export_features<float>(pos[0], pos[1], opt)
+                   : export_features<double>(pos[0], pos[1], opt);
+}
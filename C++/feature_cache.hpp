@@ -0,0 +1,129 @@
+#ifndef FEATURE_CACHE_HPP
+#define FEATURE_CACHE_HPP
+#include "feature_graph.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <filesystem>
+
+/*────────────────────  Hashing  ────────────────────*/
+/* 64-bit FNV-1a: not cryptographic, only a content address. */
+inline uint64_t fnv1a(const void* p,size_t n,uint64_t h=1469598103934665603ULL){
+    const unsigned char* b=static_cast<const unsigned char*>(p);
+    for(size_t i=0;i<n;++i){ h^=b[i]; h*=1099511628211ULL; }
+    return h;
+}
+inline uint64_t fnv1a(const std::string& s){return fnv1a(s.data(),s.size());}
+
+inline bool hash_file(const std::string& path,uint64_t& h){
+    std::ifstream fin(path,std::ios::binary);
+    if(!fin) return false;
+    std::vector<char> buf(1<<16);
+    h=1469598103934665603ULL;
+    while(fin){
+        fin.read(buf.data(),buf.size());
+        h=fnv1a(buf.data(),static_cast<size_t>(fin.gcount()),h);
+    }
+    return true;
+}
+
+inline std::string hex64(uint64_t x){
+    char buf[17]; std::snprintf(buf,sizeof buf,"%016llx",static_cast<unsigned long long>(x));
+    return buf;
+}
+
+/*────────────────────  On-disk column cache  ────────────────────*/
+/* Part of every cache file name. Bump it whenever a change to the
+   indicator code (indicators.hpp, scan.hpp, stream.hpp, the graph nodes)
+   or to the file layout below changes what a signature computes, so
+   columns cached by older builds read as misses instead of stale hits. */
+constexpr int FEATURE_CACHE_VERSION = 1;
+
+/* <dir>/<input hash>/<signature hash>.<tag>.v<version>.bin holds one
+   computed column of one raw file, where the signature is the graph node's
+   (name, parameters, dependency signatures) and tag the value type / scan
+   mode.
+   Changing one parameter only changes the signatures that depend on it, so
+   every other column is still a hit. The file repeats the full signature
+   so a hash collision reads as a miss. Files are written to a temporary
+   name and renamed, so concurrent jobs never see a partial column.
+
+   Layout: "TSFC" | u32 sizeof(T) | u64 sig length | sig | u64 rows | rows×T */
+template<class T> class FeatureCache: public SeriesStore<T>{
+public:
+    FeatureCache(const std::string& dir,uint64_t input_hash,const std::string& tag)
+        :dir_(std::filesystem::path(dir)/hex64(input_hash)),tag_(tag){}
+
+    size_t hits=0, misses=0;
+
+    bool load(const std::string& sig,std::vector<T>& out) override {
+        std::ifstream fin(file(sig),std::ios::binary);
+        char magic[4]; uint32_t width=0; uint64_t len=0, rows=0;
+        bool ok=fin.read(magic,4)&&std::memcmp(magic,"TSFC",4)==0
+              &&fin.read(reinterpret_cast<char*>(&width),sizeof width)&&width==sizeof(T)
+              &&fin.read(reinterpret_cast<char*>(&len),sizeof len)&&len==sig.size();
+        if(ok){
+            std::string stored(len,'\0');
+            ok=fin.read(&stored[0],len)&&stored==sig
+              &&fin.read(reinterpret_cast<char*>(&rows),sizeof rows);
+        }
+        if(ok){
+            out.resize(rows);
+            ok=static_cast<bool>(fin.read(reinterpret_cast<char*>(out.data()),rows*sizeof(T)));
+        }
+        ++(ok?hits:misses);
+        return ok;
+    }
+
+    void store(const std::string& sig,const std::vector<T>& s) override {
+        write(file(sig),[&](std::ofstream& f){
+            uint32_t width=sizeof(T); uint64_t len=sig.size(), rows=s.size();
+            f.write("TSFC",4);
+            f.write(reinterpret_cast<const char*>(&width),sizeof width);
+            f.write(reinterpret_cast<const char*>(&len),sizeof len);
+            f.write(sig.data(),len);
+            f.write(reinterpret_cast<const char*>(&rows),sizeof rows);
+            f.write(reinterpret_cast<const char*>(s.data()),rows*sizeof(T));
+        });
+    }
+
+    /* The date column is parsed text, shared by every tag. */
+    bool load_dates(std::vector<std::string>& dates) const {
+        std::ifstream fin(dir_/"dates.txt");
+        if(!fin) return false;
+        dates.clear();
+        for(std::string d; std::getline(fin,d);) dates.push_back(d);
+        return true;
+    }
+    void store_dates(const std::vector<std::string>& dates) const {
+        write(dir_/"dates.txt",[&](std::ofstream& f){ for(const auto& d:dates) f<<d<<'\n'; });
+    }
+
+private:
+    std::filesystem::path dir_;
+    std::string tag_;
+
+    std::filesystem::path file(const std::string& sig) const {
+        return dir_/(hex64(fnv1a(sig))+"."+tag_+".v"+std::to_string(FEATURE_CACHE_VERSION)+".bin");
+    }
+
+    /* Best effort: a cache that can't be written just stays cold. */
+    template<class Fn> void write(const std::filesystem::path& p,Fn fill) const {
+        std::error_code ec;
+        std::filesystem::create_directories(dir_,ec);
+        auto tmp=p; tmp+=".tmp"+std::to_string(std::random_device{}());
+        {
+            std::ofstream f(tmp,std::ios::binary);
+            if(!f) return;
+            fill(f);
+            if(!f){ f.close(); std::filesystem::remove(tmp,ec); return; }
+        }
+        std::filesystem::rename(tmp,p,ec);
+        if(ec) std::filesystem::remove(tmp,ec);
+    }
+};
+
+#endif
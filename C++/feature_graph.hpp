@@ -0,0 +1,127 @@
+#ifndef FEATURE_GRAPH_HPP
+#define FEATURE_GRAPH_HPP
+#include <vector>
+#include <string>
+#include <map>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <algorithm>
+
+/* Persistent store for computed series, keyed by node signature. */
+template<class T> struct SeriesStore{
+    virtual ~SeriesStore()=default;
+    virtual bool load(const std::string& sig,std::vector<T>& out)=0;
+    virtual void store(const std::string& sig,const std::vector<T>& s)=0;
+};
+
+/*────────────────────  Lazy feature DAG  ────────────────────*/
+/* Every series (raw input, shared intermediate such as an EMA or the true
+   range, or exported column) is a named node with the nodes it reads from.
+   A node must be added after its dependencies, so the graph is acyclic by
+   construction. evaluate() walks back from the requested names, computes
+   only the nodes they reach, and runs nodes of the same depth concurrently
+   since none of them can depend on another.
+
+   Each node also has a signature: its name, its parameters and, recursively,
+   the signatures of its dependencies. Two nodes with equal signatures over
+   the same inputs hold the same series, which is what a SeriesStore keys on. */
+template<class T> class FeatureGraph{
+public:
+    using Series = std::vector<T>;
+    using Args   = std::vector<const Series*>;
+    using Fn     = std::function<Series(const Args&)>;
+
+    /* Source node whose value is supplied by the caller. */
+    void input(const std::string& name,const Series& s){
+        if(has(name)) throw std::invalid_argument("duplicate node: "+name);
+        index_[name]=nodes_.size();
+        nodes_.push_back({name,name,{},nullptr,&s});
+    }
+
+    /* `params` is folded into the signature, e.g. "12" for an EMA(12). */
+    void add(const std::string& name,std::vector<std::string> deps,Fn fn,
+             const std::string& params=""){
+        if(has(name)) throw std::invalid_argument("duplicate node: "+name);
+        std::vector<size_t> ids;
+        std::string sig=name+"("+params+")[";
+        for(const auto& d:deps){
+            auto it=index_.find(d);
+            if(it==index_.end()) throw std::invalid_argument(name+" depends on unknown node "+d);
+            ids.push_back(it->second);
+            sig+=nodes_[it->second].sig+";";
+        }
+        index_[name]=nodes_.size();
+        nodes_.push_back({name,sig+"]",std::move(ids),std::move(fn),nullptr});
+    }
+
+    bool has(const std::string& name) const {return index_.count(name)!=0;}
+    const std::string& signature(const std::string& name) const {return nodes_[index_.at(name)].sig;}
+
+    /* Computes `wanted` and everything they depend on, nothing else. With a
+       store, wanted series found there are loaded instead (their private
+       dependencies are then skipped too) and the rest are saved after.   */
+    std::map<std::string,Series> evaluate(const std::vector<std::string>& wanted,
+                                          bool parallel=true,
+                                          SeriesStore<T>* store=nullptr) const {
+        if(wanted.empty()) return {};
+        std::vector<int> depth(nodes_.size(),-1);
+        std::vector<Series> val(nodes_.size());
+        std::vector<bool> loaded(nodes_.size(),false);
+        for(const auto& w:wanted){
+            auto it=index_.find(w);
+            if(it==index_.end()) throw std::invalid_argument("unknown feature: "+w);
+            size_t i=it->second;
+            if(store&&!loaded[i]&&store->load(nodes_[i].sig,val[i])){ loaded[i]=true; depth[i]=0; }
+        }
+        for(const auto& w:wanted) mark(index_.at(w),depth);
+
+        int max_depth=*std::max_element(depth.begin(),depth.end());
+        for(int lvl=1; lvl<=max_depth; ++lvl){
+            std::vector<size_t> ready;
+            for(size_t i=0;i<nodes_.size();++i) if(depth[i]==lvl) ready.push_back(i);
+
+            auto run=[&](size_t i){
+                Args a;
+                for(size_t d:nodes_[i].deps) a.push_back(nodes_[d].src?nodes_[d].src:&val[d]);
+                val[i]=nodes_[i].fn(a);
+            };
+            if(!parallel||ready.size()==1){ for(size_t i:ready) run(i); continue; }
+
+            std::vector<std::future<void>> jobs;
+            for(size_t i:ready) jobs.push_back(std::async(std::launch::async,run,i));
+            for(auto& j:jobs) j.get();
+        }
+
+        std::map<std::string,Series> out;
+        for(const auto& w:wanted){
+            if(out.count(w)) continue;
+            size_t i=index_.at(w);
+            const Series& s=nodes_[i].src?*nodes_[i].src:val[i];
+            if(store&&!loaded[i]) store->store(nodes_[i].sig,s);
+            out[w]=nodes_[i].src?s:std::move(val[i]);
+        }
+        return out;
+    }
+
+private:
+    struct Node{
+        std::string name, sig;
+        std::vector<size_t> deps;
+        Fn fn;
+        const Series* src;
+    };
+    std::vector<Node> nodes_;
+    std::map<std::string,size_t> index_;
+
+    /* depth 0 = input or loaded, otherwise 1 + deepest dependency */
+    int mark(size_t i,std::vector<int>& depth) const {
+        if(depth[i]>=0) return depth[i];
+        int d=0;
+        for(size_t p:nodes_[i].deps) d=std::max(d,mark(p,depth)+1);
+        if(!nodes_[i].src) d=std::max(d,1);
+        return depth[i]=d;
+    }
+};
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef FEATURES_HPP
+#define FEATURES_HPP
+#include "indicators.hpp"
+#include "ohlcv.hpp"
+#include "feature_graph.hpp"
+#include "scan.hpp"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+
+/*────────────────────  Exported feature columns  ────────────────────*/
+/* One column per selected features.csv field after `date`, in file order.
+   supertrend_signal holds 0/1 (NaN while the line itself is undefined). */
+template<class T> struct FeatureSet{
+    std::vector<std::string> names;
+    std::vector<std::vector<T>> cols;
+    size_t rows() const {return cols.empty()?0:cols[0].size();}
+};
+
+inline const std::vector<std::string>& feature_names(){
+    static const std::vector<std::string> names={
+        "close","macd_hist","rsi","supertrend_signal","bb_percent",
+        "stoch_k","stoch_d","atr_pct","roc","obv","vwap"};
+    return names;
+}
+
+/*────────────────────  Indicator parameters  ────────────────────*/
+/* Defaults are the periods the exported features have always used. */
+struct FeatureParams{
+    int macd_fast=12, macd_slow=26, macd_signal=9;
+    int rsi_period=14;
+    int st_period=7;    double st_mult=2.0;
+    int atr_period=10;
+    int bb_period=20;   double bb_k=2.0;
+    int stoch_k=14, stoch_d=3;
+    int roc_period=12;
+
+    /* "name=value", e.g. "rsi_period=7"; false on unknown name/bad value */
+    bool set(const std::string& kv){
+        size_t eq=kv.find('=');
+        if(eq==std::string::npos) return false;
+        std::string key=kv.substr(0,eq), val=kv.substr(eq+1);
+        const std::map<std::string,int*> ints={
+            {"macd_fast",&macd_fast},{"macd_slow",&macd_slow},{"macd_signal",&macd_signal},
+            {"rsi_period",&rsi_period},{"st_period",&st_period},{"atr_period",&atr_period},
+            {"bb_period",&bb_period},{"stoch_k",&stoch_k},{"stoch_d",&stoch_d},
+            {"roc_period",&roc_period}};
+        const std::map<std::string,double*> reals={{"st_mult",&st_mult},{"bb_k",&bb_k}};
+        try{
+            if(ints.count(key)){ int v=std::stoi(val); if(v<1) return false; *ints.at(key)=v; return true; }
+            if(reals.count(key)){ *reals.at(key)=std::stod(val); return true; }
+        } catch(...){}
+        return false;
+    }
+};
+
+/* Round-trippable text for a real-valued parameter in a node signature. */
+inline std::string param_str(double x){
+    char buf[32]; std::snprintf(buf,sizeof buf,"%.17g",x); return buf;
+}
+
+/*────────────────────  Indicator graph  ────────────────────*/
+/* Shared intermediates (EMAs, true range, both ATRs, the rolling mean/std,
+   the volume range) are their own nodes so each is computed once and only
+   when some selected column needs it. The graph keeps pointers into `d`.
+   scan != 1 swaps the EMA, Wilder RSI and OBV recurrences for the chunked
+   parallel scans in scan.hpp on that many threads (0 = all cores).      */
+template<class T> inline FeatureGraph<T> build_feature_graph(const OHLCV<T>& d,
+                                                             const FeatureParams& P=FeatureParams(),
+                                                             unsigned scan=1){
+    using A = typename FeatureGraph<T>::Args;
+    using S = std::vector<T>;
+    using std::to_string;
+    auto ema = [scan](const S& x,int p){ return scan==1?ema_safe(x,p):ema_scan(x,p,scan); };
+    FeatureGraph<T> g;
+    g.input("high", d.h); g.input("low", d.l);
+    g.input("close", d.c); g.input("volume", d.v);
+
+    /* MACD */
+    g.add("ema_fast", {"close"}, [ema,p=P.macd_fast](const A& a){ return ema(*a[0], p); },
+          to_string(P.macd_fast));
+    g.add("ema_slow", {"close"}, [ema,p=P.macd_slow](const A& a){ return ema(*a[0], p); },
+          to_string(P.macd_slow));
+    g.add("macd_line", {"ema_fast","ema_slow"}, [](const A& a){
+        const S &f=*a[0], &s=*a[1]; S m(f.size(), nan_v<T>);
+        for(size_t i=0;i<m.size();++i) if(!is_nan(f[i])&&!is_nan(s[i])) m[i]=f[i]-s[i];
+        return m;
+    });
+    g.add("macd_signal", {"macd_line"}, [ema,p=P.macd_signal](const A& a){ return ema(*a[0], p); },
+          to_string(P.macd_signal));
+    g.add("macd_hist", {"macd_line","macd_signal"}, [](const A& a){
+        const S &m=*a[0], &s=*a[1]; S h(m.size(), nan_v<T>);
+        for(size_t i=0;i<h.size();++i) if(!is_nan(m[i])&&!is_nan(s[i])) h[i]=m[i]-s[i];
+        return h;
+    });
+
+    /* Volume-weighted RSI */
+    g.add("rsi_raw", {"close"}, [scan,p=P.rsi_period](const A& a){
+        return scan==1?rsi(*a[0], p):rsi_scan(*a[0], p, scan);
+    }, to_string(P.rsi_period));
+    g.add("volume_range", {"volume"}, [](const A& a){     // {min, max-min}, NaN if empty
+        if(a[0]->empty()) return S{nan_v<T>, nan_v<T>};
+        auto mm=std::minmax_element(a[0]->begin(), a[0]->end());
+        return S{*mm.first, *mm.second-*mm.first};
+    });
+    g.add("rsi", {"rsi_raw","volume","volume_range"}, [](const A& a){
+        return volume_scale_rsi(*a[0], *a[1], (*a[2])[0], (*a[2])[1]);
+    });
+
+    /* True range feeds both Supertrend's ATR and the exported ATR */
+    g.add("true_range", {"high","low","close"}, [](const A& a){
+        return true_range(*a[0], *a[1], *a[2]);
+    });
+    g.add("atr_st", {"true_range"}, [ema,p=P.st_period](const A& a){ return ema(*a[0], p); },
+          to_string(P.st_period));
+    g.add("atr", {"true_range"}, [ema,p=P.atr_period](const A& a){ return ema(*a[0], p); },
+          to_string(P.atr_period));
+    g.add("supertrend_signal", {"high","low","close","atr_st"}, [m=P.st_mult](const A& a){
+        const S& c=*a[2]; auto st=supertrend_from_atr(*a[0], *a[1], c, *a[3], m);
+        S sig(c.size(), nan_v<T>);
+        for(size_t i=0;i<sig.size();++i) if(!is_nan(st[i])) sig[i]=c[i]>st[i]?T(1):T(0);
+        return sig;
+    }, param_str(P.st_mult));
+    g.add("atr_pct", {"atr","close"}, [](const A& a){
+        const S &t=*a[0], &c=*a[1]; S p(c.size(), nan_v<T>);
+        for(size_t i=0;i<p.size();++i) if(!is_nan(t[i])) p[i]=t[i]/c[i];
+        return p;
+    });
+
+    /* Bollinger %B over the rolling mean and std */
+    g.add("sma_bb", {"close"}, [p=P.bb_period](const A& a){ return sma(*a[0], p); },
+          to_string(P.bb_period));
+    g.add("sd_bb", {"close","sma_bb"}, [p=P.bb_period](const A& a){ return sd(*a[0], *a[1], p); },
+          to_string(P.bb_period));
+    g.add("bb_percent", {"close","sma_bb","sd_bb"}, [k=P.bb_k](const A& a){
+        return boll_percent_from(*a[0], *a[1], *a[2], k);
+    }, param_str(P.bb_k));
+
+    /* Stochastic %K & %D */
+    g.add("stoch_k", {"high","low","close"}, [p=P.stoch_k](const A& a){
+        return stoch_k(*a[0], *a[1], *a[2], p);
+    }, to_string(P.stoch_k));
+    g.add("stoch_d", {"stoch_k"}, [ema,p=P.stoch_d](const A& a){ return ema(*a[0], p); },
+          to_string(P.stoch_d));
+
+    g.add("roc", {"close"}, [p=P.roc_period](const A& a){ return roc(*a[0], p); },
+          to_string(P.roc_period));
+    g.add("obv", {"close","volume"}, [scan](const A& a){
+        return scan==1?obv(*a[0], *a[1]):obv_scan(*a[0], *a[1], scan);
+    });
+    g.add("vwap", {"high","low","close","volume"}, [](const A& a){
+        const S &h=*a[0], &l=*a[1], &c=*a[2], &v=*a[3]; S w(c.size());
+        for(size_t i=0;i<w.size();++i) w[i]=(h[i]+l[i]+c[i])/3*v[i];
+        return w;
+    });
+    return g;
+}
+
+/* Computes only `names` (distinct exported columns, in the order given),
+   loading/saving them through `store` when one is given. With scan != 1
+   every scan node brings its own threads, so the graph's levels are then
+   evaluated one node at a time rather than nodes × scan threads at once. */
+template<class T>
+inline FeatureSet<T> compute_features(const OHLCV<T>& d,
+                                      const std::vector<std::string>& names=feature_names(),
+                                      bool parallel=true,unsigned scan=1,
+                                      const FeatureParams& P=FeatureParams(),
+                                      SeriesStore<T>* store=nullptr){
+    auto g = build_feature_graph(d, P, scan);
+    auto cols = g.evaluate(names, parallel && scan==1, store);
+    FeatureSet<T> f; f.names=names;
+    for(const auto& name:names) f.cols.push_back(std::move(cols[name]));
+    return f;
+}
+
+/* Row is exported only when every selected column is defined. */
+template<class T> inline bool row_complete(const FeatureSet<T>& f,size_t i){
+    for(const auto& col:f.cols) if(is_nan(col[i])) return false;
+    return true;
+}
+
+#endif
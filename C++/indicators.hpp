@@ -6,77 +6,106 @@
 #include <numeric>
 #include <limits>
 
-inline bool is_nan(double x){return std::isnan(x);}
-constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+/* Every indicator is templated on the value type T (double or float) so the
+   whole pipeline can run in float32, which is what the NN consumes anyway.  */
+template<class T> inline bool is_nan(T x){return std::isnan(x);}
+template<class T> constexpr T nan_v = std::numeric_limits<T>::quiet_NaN();
+constexpr double NaN = nan_v<double>;
+
+/*────────────────────  Compensated sum  ────────────────────*/
+/* Neumaier summation: carries the rounding error of every add in `c`, so long
+   running sums (OBV, rolling windows, EMA) stay within a few ulp in float.   */
+template<class T> struct KSum{
+    T s=0, c=0;
+    void add(T x){
+        T t=s+x;
+        c+=(std::fabs(s)>=std::fabs(x))?(s-t)+x:(x-t)+s;
+        s=t;
+    }
+    T val() const {return s+c;}
+    void reset(){s=c=0;}
+};
 
 /*────────────────────  EMA (NaN-aware)  ────────────────────*/
-inline std::vector<double> ema_safe(const std::vector<double>& src,int p){
-    size_t n=src.size(); std::vector<double> out(n,NaN);
-    double k=2.0/(p+1.0), prev=0.0; int cnt=0;
+/* The EMA is kept as a compensated running sum of its increments
+   k*(x-prev), which is algebraically the classic x*k+prev*(1-k).          */
+template<class T>
+inline std::vector<T> ema_safe(const std::vector<T>& src,int p){
+    size_t n=src.size(); std::vector<T> out(n,nan_v<T>);
+    const T k=T(2)/(p+T(1)); KSum<T> prev; int cnt=0;
     for(size_t i=0;i<n;++i){
-        if(is_nan(src[i])){ if(cnt>=p) out[i]=prev; continue; }
-        if(cnt<p){ prev+=src[i]; if(++cnt==p){ prev/=p; out[i]=prev; } }
-        else{ prev=src[i]*k+prev*(1.0-k); out[i]=prev; }
+        if(is_nan(src[i])){ if(cnt>=p) out[i]=prev.val(); continue; }
+        if(cnt<p){
+            prev.add(src[i]);
+            if(++cnt==p){ T seed=prev.val()/p; prev.reset(); prev.add(seed); out[i]=seed; }
+        }
+        else{ prev.add(k*(src[i]-prev.val())); out[i]=prev.val(); }
     } return out;
 }
 
 /*────────────────────  SMA & STD  ────────────────────*/
-inline std::vector<double> sma(const std::vector<double>& v,int p){
-    size_t n=v.size(); std::vector<double> out(n,NaN);
-    double sum=0.0; int cnt=0;
+template<class T>
+inline std::vector<T> sma(const std::vector<T>& v,int p){
+    size_t n=v.size(); std::vector<T> out(n,nan_v<T>);
+    KSum<T> sum; int cnt=0;
     for(size_t i=0;i<n;++i){
-        if(!is_nan(v[i])){ sum+=v[i]; ++cnt; }
+        if(!is_nan(v[i])){ sum.add(v[i]); ++cnt; }
         if(i>=static_cast<size_t>(p)){
-            if(!is_nan(v[i-p])){ sum-=v[i-p]; --cnt; }
+            if(!is_nan(v[i-p])){ sum.add(-v[i-p]); --cnt; }
         }
-        if(cnt==p) out[i]=sum/p;
+        if(cnt==p) out[i]=sum.val()/p;
     } return out;
 }
-inline std::vector<double> sd(const std::vector<double>& v,
-                              const std::vector<double>& ma,int p){
-    size_t n=v.size(); std::vector<double> out(n,NaN);
-    double ss=0.0; int cnt=0;
+template<class T>
+inline std::vector<T> sd(const std::vector<T>& v,
+                         const std::vector<T>& ma,int p){
+    size_t n=v.size(); std::vector<T> out(n,nan_v<T>);
+    KSum<T> ss; int cnt=0;
     for(size_t i=0;i<n;++i){
-        if(!is_nan(v[i])&&!is_nan(ma[i])){ ss+=std::pow(v[i]-ma[i],2); ++cnt; }
+        if(!is_nan(v[i])&&!is_nan(ma[i])){ T d=v[i]-ma[i]; ss.add(d*d); ++cnt; }
         if(i>=static_cast<size_t>(p)){
             if(!is_nan(v[i-p])&&!is_nan(ma[i-p])){
-                ss-=std::pow(v[i-p]-ma[i-p],2); --cnt;
+                T d=v[i-p]-ma[i-p]; ss.add(-(d*d)); --cnt;
             }
         }
-        if(cnt==p) out[i]=std::sqrt(ss/p);
+        if(cnt==p) out[i]=std::sqrt(std::max(ss.val(),T(0))/p);
     } return out;
 }
 
 /*────────────────────  True Range & ATR  ────────────────────*/
-inline std::vector<double> true_range(const std::vector<double>& h,
-                                      const std::vector<double>& l,
-                                      const std::vector<double>& c){
-    size_t n=c.size(); std::vector<double> tr(n,NaN);
+template<class T>
+inline std::vector<T> true_range(const std::vector<T>& h,
+                                 const std::vector<T>& l,
+                                 const std::vector<T>& c){
+    size_t n=c.size(); std::vector<T> tr(n,nan_v<T>);
     for(size_t i=0;i<n;++i){
-        double hl=h[i]-l[i];
-        double hc=i?std::fabs(h[i]-c[i-1]):hl;
-        double lc=i?std::fabs(l[i]-c[i-1]):hl;
+        T hl=h[i]-l[i];
+        T hc=i?std::fabs(h[i]-c[i-1]):hl;
+        T lc=i?std::fabs(l[i]-c[i-1]):hl;
         tr[i]=std::max({hl,hc,lc});
     } return tr;
 }
-inline std::vector<double> atr(const std::vector<double>& h,
-                               const std::vector<double>& l,
-                               const std::vector<double>& c,int p=10){
+template<class T>
+inline std::vector<T> atr(const std::vector<T>& h,
+                          const std::vector<T>& l,
+                          const std::vector<T>& c,int p=10){
     return ema_safe(true_range(h,l,c),p);
 }
 
 /*────────────────────  MACD,  RSI,  Supertrend  ────────────────────*/
-struct MACD{std::vector<double> macd,signal,hist;};
-std::vector<double> rsi(const std::vector<double>&,int=7);  // Reduced default period to 7 for more sensitivity
-std::vector<double> supertrend(const std::vector<double>&,
-                               const std::vector<double>&,
-                               const std::vector<double>&,
-                               int=7,double=2.0);  // Reduced defaults: period=7, multiplier=2.0 for more signals
+template<class T> struct MACD_T{std::vector<T> macd,signal,hist;};
+using MACD=MACD_T<double>;
+template<class T> std::vector<T> rsi(const std::vector<T>&,int=7);  // Reduced default period to 7 for more sensitivity
+template<class T> std::vector<T> supertrend(const std::vector<T>&,
+                                            const std::vector<T>&,
+                                            const std::vector<T>&,
+                                            int=7,double=2.0);  // Reduced defaults: period=7, multiplier=2.0 for more signals
 
 /* MACD */
-inline MACD macd(const std::vector<double>& close,int f=12,int s=26,int sig=9){
-    size_t n=close.size(); MACD m;
-    m.macd.assign(n,NaN); m.signal.assign(n,NaN); m.hist.assign(n,NaN);
+template<class T>
+inline MACD_T<T> macd(const std::vector<T>& close,int f=12,int s=26,int sig=9){
+    size_t n=close.size(); MACD_T<T> m;
+    m.macd.assign(n,nan_v<T>); m.signal.assign(n,nan_v<T>); m.hist.assign(n,nan_v<T>);
     auto fema=ema_safe(close,f), sema=ema_safe(close,s);
     for(size_t i=0;i<n;++i)
         if(!is_nan(fema[i])&&!is_nan(sema[i])) m.macd[i]=fema[i]-sema[i];
@@ -87,137 +116,191 @@ inline MACD macd(const std::vector<double>& close,int f=12,int s=26,int sig=9){
 }
 
 /* RSI */
-inline std::vector<double> rsi(const std::vector<double>& c,int p){
-    size_t n=c.size(); std::vector<double> out(n,NaN);
+template<class T>
+inline std::vector<T> rsi(const std::vector<T>& c,int p){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
     if(n<=static_cast<size_t>(p)) return out;
-    double g=0,l=0;
+    T g=0,l=0;
     for(int i=1;i<=p;++i){
-        double d=c[i]-c[i-1]; (d>=0?g:l)+=std::fabs(d);
-    } g/=p; l/=p; out[p]=100.0-100.0/(1+g/l);
+        T d=c[i]-c[i-1]; (d>=0?g:l)+=std::fabs(d);
+    } g/=p; l/=p; out[p]=T(100)-T(100)/(1+g/l);
     for(size_t i=p+1;i<n;++i){
-        double d=c[i]-c[i-1]; double up=d>0?d:0, dn=d<0?-d:0;
+        T d=c[i]-c[i-1]; T up=d>0?d:0, dn=d<0?-d:0;
         g=(g*(p-1)+up)/p; l=(l*(p-1)+dn)/p;
-        out[i]=100.0-100.0/(1+g/l);
+        out[i]=T(100)-T(100)/(1+g/l);
     } return out;
 }
 
-/* Supertrend */
-inline std::vector<double> supertrend(const std::vector<double>& h,
-                                      const std::vector<double>& l,
-                                      const std::vector<double>& c,
-                                      int p,double mlt){
-    size_t n=c.size(); std::vector<double> st(n,NaN);
-    auto a=atr(h,l,c,p);
+/* Supertrend (band around hl2 from a precomputed ATR series) */
+template<class T>
+inline std::vector<T> supertrend_from_atr(const std::vector<T>& h,
+                                          const std::vector<T>& l,
+                                          const std::vector<T>& c,
+                                          const std::vector<T>& a,double mlt){
+    size_t n=c.size(); std::vector<T> st(n,nan_v<T>);
     for(size_t i=0;i<n;++i){
-        if(is_nan(a[i])) a[i]=0.0;
-        double hl2=0.5*(h[i]+l[i]);
-        double up=hl2+mlt*a[i], low=hl2-mlt*a[i];
+        T ai=is_nan(a[i])?T(0):a[i];
+        T hl2=T(0.5)*(h[i]+l[i]);
+        T up=hl2+T(mlt)*ai, low=hl2-T(mlt)*ai;
         if(i==0){ st[i]=low; continue; }
         st[i]=(c[i]>st[i-1])?std::max(low,st[i-1])
                             :std::min(up ,st[i-1]);
     } return st;
 }
+template<class T>
+inline std::vector<T> supertrend(const std::vector<T>& h,
+                                 const std::vector<T>& l,
+                                 const std::vector<T>& c,
+                                 int p,double mlt){
+    return supertrend_from_atr(h,l,c,atr(h,l,c,p),mlt);
+}
 
 /*────────────────────  NEW INDICATORS  ────────────────────*/
 /* Bollinger %B */
-inline std::vector<double> boll_percent(const std::vector<double>& c,int p=20,double k=2.0){
-    auto ma=sma(c,p); auto sdv=sd(c,ma,p);
-    size_t n=c.size(); std::vector<double> out(n,NaN);
+template<class T>
+inline std::vector<T> boll_percent_from(const std::vector<T>& c,
+                                        const std::vector<T>& ma,
+                                        const std::vector<T>& sdv,double k=2.0){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
     for(size_t i=0;i<n;++i)
         if(!is_nan(ma[i])&&!is_nan(sdv[i])&&sdv[i]!=0)
-            out[i]=(c[i]-ma[i])/(k*sdv[i]) + 0.5;       // 0=bott,1=top
+            out[i]=(c[i]-ma[i])/(T(k)*sdv[i]) + T(0.5);       // 0=bott,1=top
     return out;
 }
+template<class T>
+inline std::vector<T> boll_percent(const std::vector<T>& c,int p=20,double k=2.0){
+    auto ma=sma(c,p);
+    return boll_percent_from(c,ma,sd(c,ma,p),k);
+}
 
 /* Stochastic %K & %D */
-struct STOCH{std::vector<double> k,d;};
-inline STOCH stoch(const std::vector<double>& h,
-                   const std::vector<double>& l,
-                   const std::vector<double>& c,
-                   int klen=14,int dlen=3){
-    size_t n=c.size(); STOCH s;
-    s.k.assign(n,NaN); s.d.assign(n,NaN);
+template<class T> struct STOCH_T{std::vector<T> k,d;};
+using STOCH=STOCH_T<double>;
+template<class T>
+inline std::vector<T> stoch_k(const std::vector<T>& h,
+                              const std::vector<T>& l,
+                              const std::vector<T>& c,int klen=14){
+    size_t n=c.size(); std::vector<T> k(n,nan_v<T>);
     for(size_t i=0;i<n;++i){
         if(i+1<static_cast<size_t>(klen)) continue;
-        double hh=*std::max_element(h.begin()+i+1-klen,h.begin()+i+1);
-        double ll=*std::min_element(l.begin()+i+1-klen,l.begin()+i+1);
+        T hh=*std::max_element(h.begin()+i+1-klen,h.begin()+i+1);
+        T ll=*std::min_element(l.begin()+i+1-klen,l.begin()+i+1);
         if(hh==ll) continue;
-        s.k[i]=100.0*(c[i]-ll)/(hh-ll);
+        k[i]=T(100)*(c[i]-ll)/(hh-ll);
     }
+    return k;
+}
+template<class T>
+inline STOCH_T<T> stoch(const std::vector<T>& h,
+                        const std::vector<T>& l,
+                        const std::vector<T>& c,
+                        int klen=14,int dlen=3){
+    STOCH_T<T> s;
+    s.k=stoch_k(h,l,c,klen);
     s.d=ema_safe(s.k,dlen);
     return s;
 }
 
 /* Rate of Change */
-inline std::vector<double> roc(const std::vector<double>& c,int p=12){
-    size_t n=c.size(); std::vector<double> out(n,NaN);
+template<class T>
+inline std::vector<T> roc(const std::vector<T>& c,int p=12){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
     for(size_t i=p;i<n;++i)
-        if(!is_nan(c[i-p])&&c[i-p]!=0) out[i]=100.0*(c[i]-c[i-p])/c[i-p];
+        if(!is_nan(c[i-p])&&c[i-p]!=0) out[i]=T(100)*(c[i]-c[i-p])/c[i-p];
     return out;
 }
 
 /* On-Balance Volume */
-inline std::vector<double> obv(const std::vector<double>& c,
-                               const std::vector<double>& v){
-    size_t n=c.size(); std::vector<double> out(n,NaN);
-    double running=0.0;
+template<class T>
+inline std::vector<T> obv(const std::vector<T>& c,
+                          const std::vector<T>& v){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
+    KSum<T> running;
     for(size_t i=1;i<n;++i){
         if(is_nan(c[i])||is_nan(c[i-1])) continue;
-        running+=(c[i]>c[i-1]?v[i]:(c[i]<c[i-1]? -v[i]:0));
-        out[i]=running;
+        running.add(c[i]>c[i-1]?v[i]:(c[i]<c[i-1]? -v[i]:T(0)));
+        out[i]=running.val();
     } return out;
 }
 
-inline std::vector<double> vwma(const std::vector<double>& prices,
-                               const std::vector<double>& volumes,
-                               int period=20) {
+template<class T>
+inline std::vector<T> vwma(const std::vector<T>& prices,
+                           const std::vector<T>& volumes,
+                           int period=20) {
     size_t n = prices.size();
-    std::vector<double> out(n, NaN);
-    double sum_price = 0.0, sum_vol = 0.0;
+    std::vector<T> out(n, nan_v<T>);
+    KSum<T> sum_price, sum_vol;
     int cnt = 0;
-    
+
     for(size_t i=0; i<n; ++i) {
         if(!is_nan(prices[i])) {
-            sum_price += prices[i] * volumes[i];
-            sum_vol += volumes[i];
+            sum_price.add(prices[i] * volumes[i]);
+            sum_vol.add(volumes[i]);
             ++cnt;
         }
-        
+
         if(i >= static_cast<size_t>(period)) {
             size_t j = i - period;
             if(!is_nan(prices[j])) {
-                sum_price -= prices[j] * volumes[j];
-                sum_vol -= volumes[j];
+                sum_price.add(-(prices[j] * volumes[j]));
+                sum_vol.add(-volumes[j]);
                 --cnt;
             }
         }
-        
-        if(cnt == period && sum_vol != 0) {
-            out[i] = sum_price / sum_vol;
+
+        if(cnt == period && sum_vol.val() != 0) {
+            out[i] = sum_price.val() / sum_vol.val();
         }
     }
     return out;
 }
 
 /* Chande Momentum Oscillator */
-inline std::vector<double> cmo(const std::vector<double>& prices, int period=14) {
+template<class T>
+inline std::vector<T> cmo(const std::vector<T>& prices, int period=14) {
     size_t n = prices.size();
-    std::vector<double> out(n, NaN);
-    
+    std::vector<T> out(n, nan_v<T>);
+
     for(size_t i=period; i<n; ++i) {
-        double sum_up = 0.0, sum_down = 0.0;
-        
+        T sum_up = 0, sum_down = 0;
+
         for(size_t j=i-period+1; j<=i; ++j) {
-            double diff = prices[j] - prices[j-1];
+            T diff = prices[j] - prices[j-1];
             if(diff > 0) sum_up += diff;
             else sum_down -= diff;
         }
-        
+
         if(sum_up + sum_down != 0) {
-            out[i] = 100.0 * (sum_up - sum_down) / (sum_up + sum_down);
+            out[i] = T(100) * (sum_up - sum_down) / (sum_up + sum_down);
         }
     }
     return out;
 }
 
+/* Volume-weighted RSI: RSI pulled towards 50 on light volume and pushed
+   away from it on heavy volume (scale 0.8 .. 1.2 over the volume range).
+   Left unscaled when the range is empty, zero or not finite.             */
+template<class T>
+inline std::vector<T> volume_scale_rsi(std::vector<T> rsi_val,
+                                       const std::vector<T>& volumes,
+                                       T min_vol, T vol_range) {
+    if(!std::isfinite(min_vol) || !std::isfinite(vol_range) || !(vol_range > 0)) return rsi_val;
+    for(size_t i=0; i<rsi_val.size(); ++i) {
+        if(!is_nan(rsi_val[i]) && !is_nan(volumes[i])) {
+            T vol_norm = (volumes[i] - min_vol) / vol_range;
+            T vol_scale = T(0.8) + T(0.4) * vol_norm;
+            rsi_val[i] = 50 + (rsi_val[i]-50)*vol_scale;
+        }
+    }
+    return rsi_val;
+}
+template<class T>
+inline std::vector<T> volume_weighted_rsi(const std::vector<T>& prices,
+                                          const std::vector<T>& volumes,
+                                          int period=14) {
+    if(volumes.empty()) return rsi(prices, period);
+    auto mm = std::minmax_element(volumes.begin(), volumes.end());
+    return volume_scale_rsi(rsi(prices, period), volumes, *mm.first, *mm.second - *mm.first);
+}
+
 #endif
@@ -0,0 +1,54 @@
+#ifndef OHLCV_HPP
+#define OHLCV_HPP
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/*────────────────────  Raw OHLCV series  ────────────────────*/
+template<class T> struct OHLCV{
+    std::vector<std::string> date;
+    std::vector<T> o,h,l,c,adj,v;
+    size_t size() const {return c.size();}
+    void clear(){ date.clear(); o.clear(); h.clear(); l.clear(); c.clear(); adj.clear(); v.clear(); }
+};
+
+template<class T> inline bool to_value(std::string tok,T& out){
+    tok.erase(std::remove(tok.begin(),tok.end(),'"'),tok.end());
+    try{ out=static_cast<T>(std::stod(tok)); } catch(...){ return false; }
+    return true;
+}
+
+/* Parses one "date,open,high,low,close,adj_close,volume" data line. */
+template<class T> inline void parse_row(const std::string& line,OHLCV<T>& d){
+    std::stringstream ss(line);
+    std::string dt,tok; T tmp;
+
+    if(!std::getline(ss,dt,',')) return;
+    d.date.push_back(dt.substr(0,10));
+
+    if(!std::getline(ss,tok,',')||!to_value(tok,tmp)) return;
+    d.o.push_back(tmp);
+    if(!std::getline(ss,tok,',')||!to_value(tok,tmp)) return;
+    d.h.push_back(tmp);
+    if(!std::getline(ss,tok,',')||!to_value(tok,tmp)) return;
+    d.l.push_back(tmp);
+    if(!std::getline(ss,tok,',')||!to_value(tok,tmp)) return;
+    d.c.push_back(tmp);
+    if(!std::getline(ss,tok,',')||!to_value(tok,tmp)) return;
+    d.adj.push_back(tmp);
+    std::getline(ss,tok); to_value(tok,tmp); d.v.push_back(tmp);
+}
+
+/* Loads a whole CSV (header skipped). Returns false if it can't be opened. */
+template<class T> inline bool load_ohlcv(const std::string& path,OHLCV<T>& d){
+    std::ifstream fin(path);
+    if(!fin) return false;
+    std::string line;
+    std::getline(fin,line); // header
+    while(std::getline(fin,line)) parse_row(line,d);
+    return true;
+}
+
+#endif
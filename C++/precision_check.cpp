@@ -0,0 +1,187 @@
+#include "features.hpp"
+#include "stream.hpp"
+#include "cli.hpp"
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <random>
+
+/* Compares `test` against the reference `ref` over the rows export_features
+   would keep and prints, per column, the largest deviation. Relative error
+   is taken against max(|ref|, 1) so near-zero columns such as macd_hist are
+   not blown up by tiny denominators. Returns true if all are within tol. */
+template<class R,class U>
+static bool report(const char* title, const FeatureSet<R>& ref, const FeatureSet<U>& test,
+                   const std::vector<std::string>& date, double tol) {
+    size_t n = ref.rows();
+    std::vector<double> max_abs(ref.cols.size(), 0.0), max_rel(ref.cols.size(), 0.0);
+    std::vector<size_t> worst(ref.cols.size(), 0);
+    size_t compared = 0, mask_diff = 0;
+    for(size_t i=0; i<n; ++i) {
+        bool kr = row_complete(ref, i), kt = row_complete(test, i);
+        if(kr != kt) { ++mask_diff; continue; }
+        if(!kr) continue;
+        ++compared;
+        for(size_t j=0; j<ref.cols.size(); ++j) {
+            double r = ref.cols[j][i];
+            double err = std::fabs(static_cast<double>(test.cols[j][i]) - r);
+            double rel = err / std::max(std::fabs(r), 1.0);
+            if(err > max_abs[j]) max_abs[j] = err;
+            if(rel > max_rel[j]) { max_rel[j] = rel; worst[j] = i; }
+        }
+    }
+
+    std::cout << "── " << title << " ──\n"
+              << "Rows compared      : " << compared << "\n"
+              << "Row-mask mismatches: " << mask_diff << "\n\n"
+              << std::left << std::setw(18) << "column"
+              << std::setw(16) << "max_abs_err" << std::setw(16) << "max_rel_err"
+              << "worst_date\n";
+    bool ok = mask_diff == 0;
+    for(size_t j=0; j<ref.cols.size(); ++j) {
+        std::cout << std::left << std::setw(18) << ref.names[j] << std::scientific
+                  << std::setprecision(3) << std::setw(16) << max_abs[j]
+                  << std::setw(16) << max_rel[j]
+                  << (max_rel[j] > 0 ? date[worst[j]] : "-") << '\n';
+        // supertrend_signal is 0/1: any flip is a deviation of 1 by design
+        if(ref.names[j] != "supertrend_signal" && max_rel[j] > tol) ok = false;
+    }
+    std::cout << (ok ? "✓ within " : "✗ exceeds ") << tol << " relative error\n\n";
+    return ok;
+}
+
+/* Times each scan against its sequential indicator on a synthetic random
+   walk long enough for the scans to split it into chunks. A scan does
+   about twice the arithmetic of the plain loop, so even on one core it
+   should stay within `max_ratio` of it. A larger gap means something
+   like a denormal stall in the chunk corrections.                     */
+static bool timing(unsigned threads, double max_ratio) {
+    const size_t n = 8u << 20;
+    std::mt19937 rng(1);
+    std::normal_distribution<double> N(0, 1);
+    std::vector<double> c(n), v(n);
+    double p = 100;
+    for(size_t i=0; i<n; ++i) { p += N(rng); c[i] = p; v[i] = 1000 + std::fabs(N(rng)) * 500; }
+
+    auto secs = [](auto fn) {
+        auto t0 = std::chrono::steady_clock::now();
+        volatile double sink = fn().back(); (void)sink;
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+    struct Row { const char* name; double seq, scan; };
+    std::vector<Row> rows = {
+        {"ema",  secs([&]{ return ema_safe(c, 12); }), secs([&]{ return ema_scan(c, 12, threads); })},
+        {"rsi",  secs([&]{ return rsi(c, 14); }),      secs([&]{ return rsi_scan(c, 14, threads); })},
+        {"obv",  secs([&]{ return obv(c, v); }),       secs([&]{ return obv_scan(c, v, threads); })},
+        {"vwma", secs([&]{ return vwma(c, v); }),      secs([&]{ return vwma_scan(c, v, 20, threads); })}};
+
+    std::cout << "── scan timing (" << n << " points, " << threads << " threads) ──\n"
+              << std::left << std::setw(18) << "indicator" << std::setw(16) << "sequential_s"
+              << std::setw(16) << "scan_s" << "ratio\n";
+    bool ok = true;
+    for(const auto& r : rows) {
+        std::cout << std::left << std::setw(18) << r.name << std::fixed << std::setprecision(3)
+                  << std::setw(16) << r.seq << std::setw(16) << r.scan << r.scan / r.seq << '\n';
+        if(r.scan > max_ratio * r.seq) ok = false;
+    }
+    std::cout << std::defaultfloat << (ok ? "✓ every scan within " : "✗ a scan exceeds ")
+              << max_ratio << "x its sequential time\n\n";
+    return ok;
+}
+
+/* Rows [b, e) of d as their own series, as export_stream's reader cuts them. */
+template<class T>
+static OHLCV<T> slice(const OHLCV<T>& d, size_t b, size_t e) {
+    OHLCV<T> s;
+    s.date.assign(d.date.begin()+b, d.date.begin()+e);
+    s.h.assign(d.h.begin()+b, d.h.begin()+e); s.l.assign(d.l.begin()+b, d.l.begin()+e);
+    s.c.assign(d.c.begin()+b, d.c.begin()+e); s.v.assign(d.v.begin()+b, d.v.begin()+e);
+    return s;
+}
+
+/* Streams the raw file through FeatureStream in `chunk`-row pieces, for
+   several parameter sets and column selections, and requires the result
+   to be bit-identical to the in-memory graph, the NaN pattern included.  */
+static bool stream_check(const std::string& path, const OHLCV<double>& d) {
+    double vmin, vrange;
+    if(!volume_range(path, vmin, vrange)) return false;
+    FeatureParams odd;
+    for(const char* kv : {"macd_fast=5", "macd_slow=17", "macd_signal=4", "rsi_period=7",
+                          "st_period=3", "st_mult=3.5", "atr_period=4", "bb_period=9",
+                          "bb_k=1.5", "stoch_k=9", "stoch_d=5", "roc_period=3"})
+        odd.set(kv);
+    struct Case { const char* title; FeatureParams P; std::vector<std::string> names; };
+    std::vector<Case> cases = {
+        {"default params", FeatureParams(), feature_names()},
+        {"non-default params", odd, feature_names()},
+        {"stoch_d,atr_pct only", odd, {"stoch_d", "atr_pct"}},
+        {"supertrend_signal,rsi only", FeatureParams(), {"rsi", "supertrend_signal"}}};
+
+    std::cout << "── streaming vs in-memory (bit-identical) ──\n";
+    bool ok = true;
+    for(const auto& cs : cases) {
+        auto ref = compute_features(d, cs.names, false, 1, cs.P);
+        for(size_t chunk : {size_t(1), size_t(7), size_t(37), size_t(4099), d.size() + 1}) {
+            FeatureStream<double> fs(cs.names, vmin, vrange, cs.P);
+            FeatureSet<double> got, part;
+            got.cols.resize(cs.names.size());
+            for(size_t b=0; b<d.size(); b+=chunk) {
+                fs.process(slice(d, b, std::min(d.size(), b + chunk)), part);
+                for(size_t j=0; j<part.cols.size(); ++j)
+                    got.cols[j].insert(got.cols[j].end(), part.cols[j].begin(), part.cols[j].end());
+            }
+            size_t diff = 0;
+            for(size_t j=0; j<ref.cols.size(); ++j)
+                for(size_t i=0; i<ref.rows(); ++i) {
+                    double a = ref.cols[j][i], b = i < got.cols[j].size() ? got.cols[j][i] : -1;
+                    if(!(a == b || (std::isnan(a) && std::isnan(b)))) ++diff;
+                }
+            std::cout << std::left << std::setw(28) << cs.title << "chunk " << std::setw(8)
+                      << chunk << (diff ? "✗ " : "✓ ") << diff << " value(s) differ\n";
+            if(diff) ok = false;
+        }
+    }
+    std::cout << '\n';
+    return ok;
+}
+
+/* Runs the feature pipeline on the same raw file as
+     1. double, sequential (reference),
+     2. float32, sequential,
+     3. double, parallel prefix scans forced onto every core (plus
+        vwma_scan against vwma, which no exported column uses),
+   and reports the deviation of 2 and 3 from the reference, then checks
+   the streaming path (stream_check()) and times the scans (timing()).  */
+int main(int argc, char* argv[]) {
+    double f32_tol = 1e-4, scan_tol = 1e-9;
+    if(argc < 2 || argc > 4 || (argc >= 3 && (!parse_real(argv[2], f32_tol) || f32_tol < 0))
+       || (argc >= 4 && (!parse_real(argv[3], scan_tol) || scan_tol < 0))) {
+        std::cerr << "Usage: precision_check.exe <raw> [f32_max_rel_err] [scan_max_rel_err]\n";
+        return 1;
+    }
+
+    OHLCV<double> dd; OHLCV<float> df;
+    if(!load_ohlcv(argv[1], dd) || !load_ohlcv(argv[1], df)) {
+        std::cerr << "Cannot open " << argv[1] << '\n'; return 1;
+    }
+    unsigned cores = std::max(2u, std::thread::hardware_concurrency());
+    auto Fd = compute_features(dd);
+    auto Ff = compute_features(df);
+    auto Fs = compute_features(dd, feature_names(), true, cores);
+
+    // VWMA is not an exported column but has a scan version of its own
+    FeatureSet<double> Vd{{"vwma"}, {vwma(dd.c, dd.v)}};
+    FeatureSet<double> Vs{{"vwma"}, {vwma_scan(dd.c, dd.v, 20, cores)}};
+
+    bool ok = report("float32 vs double", Fd, Ff, dd.date, f32_tol);
+    std::string scan_title = "parallel scan (" + std::to_string(cores) + " threads) vs sequential";
+    ok = report(scan_title.c_str(), Fd, Fs, dd.date, scan_tol) && ok;
+    ok = report(("vwma " + scan_title).c_str(), Vd, Vs, dd.date, scan_tol) && ok;
+    ok = stream_check(argv[1], dd) && ok;
+    ok = timing(cores, 4.0) && ok;
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,220 @@
+#ifndef RISK_HPP
+#define RISK_HPP
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+/*────────────────────  Blocked symmetric matrix  ────────────────────*/
+/* k×k symmetric matrix stored as the upper triangle of B×B tiles, each tile
+   contiguous, tiles in row-major order. A rank-1 update walks the tiles
+   once, touching k²/2 (+ diagonal tiles) elements with unit-stride inner
+   loops that stay in L1 for a 16×16 double tile.                         */
+template<class T,size_t B=16> class SymMatrix{
+public:
+    explicit SymMatrix(size_t k):k_(k),nb_((k+B-1)/B),
+        xp_(nb_*B,T(0)),yp_(nb_*B,T(0)),data_(nb_*(nb_+1)/2*B*B,T(0)){}
+
+    size_t size() const {return k_;}
+    void clear(){ std::fill(data_.begin(),data_.end(),T(0)); }
+
+    /* C = beta*C + alpha*x*xᵀ, x has size() entries */
+    void rank1(T alpha,const T* x,T beta=T(1)){
+        std::copy(x,x+k_,xp_.begin());          // zero-padded to whole tiles
+        T* t=data_.data();
+        for(size_t bi=0;bi<nb_;++bi)
+            for(size_t bj=bi;bj<nb_;++bj,t+=B*B){
+                const T *xi=&xp_[bi*B], *xj=&xp_[bj*B];
+                for(size_t r=0;r<B;++r){
+                    T a=alpha*xi[r]; T* row=t+r*B;
+                    for(size_t c=0;c<B;++c) row[c]=beta*row[c]+a*xj[c];
+                }
+            }
+    }
+
+    T operator()(size_t i,size_t j) const {
+        if(i>j) std::swap(i,j);
+        size_t bi=i/B, bj=j/B;
+        return data_[tile(bi,bj)+(i%B)*B+(j%B)];
+    }
+
+    /* xᵀ C x */
+    T quad(const T* x) const {
+        return quad_(x,[this](size_t o){return data_[o];});
+    }
+    /* xᵀ (C ⊘ D) x for a same-sized D, taking C/D as 0 where D is 0 */
+    T quad(const T* x,const SymMatrix& den) const {
+        return quad_(x,[this,&den](size_t o){
+            return den.data_[o]!=0?data_[o]/den.data_[o]:T(0);
+        });
+    }
+
+private:
+    size_t k_, nb_;
+    mutable std::vector<T> xp_, yp_;
+    std::vector<T> data_;
+    size_t tile(size_t bi,size_t bj) const {
+        return (bi*nb_-bi*(bi-1)/2+(bj-bi))*B*B;   // tiles in rows < bi, then offset
+    }
+
+    /* elem(o): the matrix element at storage offset o */
+    template<class E> T quad_(const T* x,E elem) const {
+        std::copy(x,x+k_,xp_.begin());
+        std::fill(yp_.begin(),yp_.end(),T(0));
+        size_t t=0;
+        for(size_t bi=0;bi<nb_;++bi)
+            for(size_t bj=bi;bj<nb_;++bj,t+=B*B){
+                const T *xi=&xp_[bi*B], *xj=&xp_[bj*B];
+                T *yi=&yp_[bi*B], *yj=&yp_[bj*B];
+                for(size_t r=0;r<B;++r){
+                    size_t row=t+r*B; T acc=0;
+                    for(size_t c=0;c<B;++c) acc+=elem(row+c)*xj[c];
+                    yi[r]+=acc;
+                    if(bi!=bj) for(size_t c=0;c<B;++c) yj[c]+=elem(row+c)*xi[r];
+                }
+            }
+        T q=0;
+        for(size_t i=0;i<k_;++i) q+=xp_[i]*yp_[i];
+        return q;
+    }
+};
+
+/*────────────────────  Rolling covariance  ────────────────────*/
+/* Sample covariance of the last `window` return vectors, kept as running
+   Σx and Σxxᵀ: each bar adds the new vector and removes the one leaving
+   the window (two rank-1 updates, O(k²)). The running sums are rebuilt
+   from the window every `refresh` bars so cancellation error can't build
+   up over long histories.
+   A missing return (NaN) enters the sums as 0 but is not an observation:
+   each symbol counts its real returns in the window and is ready(i) only
+   once all `window` of them are real. Among ready symbols the zero-filled
+   sums are exact, so cov() is NaN for any pair with a symbol not ready. */
+template<class T> class RollingCov{
+public:
+    RollingCov(size_t k,size_t window,size_t refresh=0)
+        :k_(k),w_(window),refresh_(refresh?refresh:64*window),
+         ring_(k*window,T(0)),seen_(k*window,0),cnt_(k,0),s1_(k,T(0)),s2_(k){}
+
+    size_t size() const {return k_;}
+    bool ready() const {return m_==w_;}
+    bool ready(size_t i) const {return cnt_[i]==w_;}
+
+    /* r: k returns for this bar (NaN = no observation) */
+    void push(const T* r){
+        T* slot=&ring_[pos_*k_];
+        unsigned char* seen=&seen_[pos_*k_];
+        if(m_==w_){
+            s2_.rank1(T(-1),slot);
+            for(size_t i=0;i<k_;++i){ s1_[i]-=slot[i]; cnt_[i]-=seen[i]; }
+        } else ++m_;
+        for(size_t i=0;i<k_;++i){
+            seen[i]=!std::isnan(r[i]); cnt_[i]+=seen[i];
+            slot[i]=seen[i]?r[i]:T(0);
+        }
+        s2_.rank1(T(1),slot);
+        for(size_t i=0;i<k_;++i) s1_[i]+=slot[i];
+        pos_=(pos_+1)%w_;
+        if(++since_==refresh_) rebuild();
+    }
+
+    T cov(size_t i,size_t j) const {
+        if(!ready(i)||!ready(j)) return std::numeric_limits<T>::quiet_NaN();
+        return (s2_(i,j)-s1_[i]*s1_[j]/m_)/(m_-1);
+    }
+    T var(size_t i) const {return cov(i,i);}
+
+    /* wᵀ Σ w without forming Σ: (wᵀS2w - (w·S1)²/m)/(m-1); w must be 0 on
+       symbols that are not ready.                                        */
+    T portfolio_var(const std::vector<T>& w) const {
+        T d=0;
+        for(size_t i=0;i<k_;++i) d+=w[i]*s1_[i];
+        return (s2_.quad(w.data())-d*d/m_)/(m_-1);
+    }
+
+private:
+    size_t k_, w_, refresh_, m_=0, pos_=0, since_=0;
+    std::vector<T> ring_;
+    std::vector<unsigned char> seen_;   // ring_ entry was a real return
+    std::vector<size_t> cnt_;           // real returns per symbol in the window
+    std::vector<T> s1_;
+    SymMatrix<T> s2_;
+
+    void rebuild(){
+        since_=0; s2_.clear(); std::fill(s1_.begin(),s1_.end(),T(0));
+        for(size_t b=0;b<m_;++b){
+            const T* x=&ring_[b*k_];
+            s2_.rank1(T(1),x);
+            for(size_t i=0;i<k_;++i) s1_[i]+=x[i];
+        }
+    }
+};
+
+/*────────────────────  EWMA covariance  ────────────────────*/
+/* RiskMetrics-style zero-mean EWMA, Σ ← λΣ + (1-λ)rrᵀ, as a fused rank-1
+   pass per bar. Started from Σ=0, so Σ is normalised by the EWMA weight D
+   each pair actually received, D ← λD + (1-λ)mmᵀ with m the mask of real
+   returns: Σ⊘D is the pairwise-complete estimate and, with no gaps, the
+   usual 1/(1-λⁿ) bias correction. Symbol i is ready(i) after ~1/(1-λ) real
+   returns of its own, whenever it started trading.                     */
+template<class T> class EwmaCov{
+public:
+    EwmaCov(size_t k,T lambda)
+        :k_(k),lambda_(lambda),warmup_(static_cast<size_t>(std::ceil(1/(1-lambda)))),
+         x_(k),m_(k),n_(k,0),s_(k),d_(k){}
+
+    size_t size() const {return k_;}
+    bool ready() const {return bars_>=warmup_;}
+    bool ready(size_t i) const {return n_[i]>=warmup_;}
+
+    /* r: k returns for this bar (NaN = no observation) */
+    void push(const T* r){
+        for(size_t i=0;i<k_;++i){
+            bool seen=!std::isnan(r[i]);
+            x_[i]=seen?r[i]:T(0); m_[i]=seen; n_[i]+=seen;
+        }
+        s_.rank1(1-lambda_,x_.data(),lambda_);
+        d_.rank1(1-lambda_,m_.data(),lambda_);
+        ++bars_;
+    }
+
+    T cov(size_t i,size_t j) const {
+        if(!ready(i)||!ready(j)||!(d_(i,j)>0)) return std::numeric_limits<T>::quiet_NaN();
+        return s_(i,j)/d_(i,j);
+    }
+    T var(size_t i) const {return cov(i,i);}
+    /* wᵀ(Σ⊘D)w; w must be 0 on symbols that are not ready */
+    T portfolio_var(const std::vector<T>& w) const {return s_.quad(w.data(),d_);}
+
+private:
+    size_t k_; T lambda_; size_t warmup_, bars_=0;
+    std::vector<T> x_, m_;
+    std::vector<size_t> n_;     // real returns seen per symbol
+    SymMatrix<T> s_, d_;
+};
+
+/*────────────────────  Volatility-targeted sizing  ────────────────────*/
+/* Position per symbol for one bar: inverse-volatility weights on the
+   active symbols (signal ≠ 0, signed by the signal), scaled together so
+   the portfolio's ex-ante annualised volatility √(periods·wᵀΣw) equals
+   `target`, then capped at `max_gross` total absolute exposure. Symbols
+   the estimator is not ready(i) for get 0; zero vector when it is not
+   ready at all or the portfolio has no risk.                           */
+template<class T,class Cov>
+inline std::vector<T> vol_target_sizes(const Cov& cov,const std::vector<T>& signal,
+                                       T target,T periods=252,T max_gross=2){
+    size_t k=cov.size(); std::vector<T> w(k,T(0));
+    if(!cov.ready()) return w;
+    for(size_t i=0;i<k;++i){
+        if(signal[i]==0||!cov.ready(i)) continue;
+        T v=cov.var(i);
+        if(v>0) w[i]=signal[i]/std::sqrt(v);
+    }
+    T pv=cov.portfolio_var(w);
+    if(!(pv>0)) return std::vector<T>(k,T(0));
+    T scale=target/std::sqrt(periods*pv), gross=0;
+    for(auto& x:w){ x*=scale; gross+=std::fabs(x); }
+    if(gross>max_gross) for(auto& x:w) x*=max_gross/gross;
+    return w;
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "risk.hpp"
+#include <vector>
+#include <random>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+
+/* Checks RollingCov and EwmaCov against a brute-force recomputation on
+   synthetic returns where one symbol starts trading late and another has
+   gaps: every ready pair's covariance and the portfolio variance must
+   match within tol, readiness must follow each symbol's own observations,
+   and vol_target_sizes must give 0 to every symbol that is not ready.  */
+
+using Mat = std::vector<std::vector<double>>;   // returns[bar][symbol], NaN = missing
+
+static bool close_to(double a, double b, double tol) {
+    return std::fabs(a - b) <= tol * std::max(std::fabs(b), 1e-12);
+}
+
+struct Tally {
+    const char* title; size_t compared = 0, failed = 0; double max_rel = 0;
+    void check(bool ok, double a = 0, double b = 0) {
+        ++compared;
+        if(!ok) ++failed;
+        if(b != 0) max_rel = std::max(max_rel, std::fabs(a - b) / std::fabs(b));
+    }
+    bool print(double tol) const {
+        std::cout << std::left << std::setw(26) << title << std::scientific << std::setprecision(3)
+                  << "checks " << std::setw(8) << compared << " failed " << std::setw(6) << failed
+                  << " max_rel_err " << max_rel << '\n';
+        return failed == 0 && max_rel <= tol;
+    }
+};
+
+/* Sample covariance over the last W bars, NaN unless both have all W. */
+static double brute_rolling(const Mat& R, size_t t, size_t W, size_t i, size_t j) {
+    double mi = 0, mj = 0;
+    for(size_t b=t+1-W; b<=t; ++b) {
+        if(std::isnan(R[b][i]) || std::isnan(R[b][j])) return NAN;
+        mi += R[b][i]; mj += R[b][j];
+    }
+    mi /= W; mj /= W;
+    double c = 0;
+    for(size_t b=t+1-W; b<=t; ++b) c += (R[b][i] - mi) * (R[b][j] - mj);
+    return c / (W - 1);
+}
+
+/* Zero-mean EWMA over the bars where both were observed, normalised by
+   the weight those bars received.                                     */
+static double brute_ewma(const Mat& R, size_t t, double lambda, size_t i, size_t j) {
+    double s = 0, d = 0, wt = 1 - lambda;
+    for(size_t b=t+1; b-- > 0; wt *= lambda)
+        if(!std::isnan(R[b][i]) && !std::isnan(R[b][j])) { s += wt * R[b][i] * R[b][j]; d += wt; }
+    return d > 0 ? s / d : NAN;
+}
+
+template<class Cov, class Brute, class Ready>
+static void run(Cov& cov, const Mat& R, Brute brute, Ready brute_ready, Tally& c, Tally& p, Tally& z) {
+    size_t k = R[0].size();
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> U(-1, 1);
+    for(size_t t=0; t<R.size(); ++t) {
+        cov.push(R[t].data());
+        if(!cov.ready()) continue;
+        std::vector<double> w(k, 0.0), signal(k, 1.0);
+        for(size_t i=0; i<k; ++i) {
+            z.check(cov.ready(i) == brute_ready(t, i));
+            if(!cov.ready(i)) continue;
+            w[i] = U(rng);
+            for(size_t j=i; j<k; ++j) {
+                if(!cov.ready(j)) continue;
+                double b = brute(t, i, j);
+                c.check(close_to(cov.cov(i, j), b, 1e-9), cov.cov(i, j), b);
+            }
+        }
+        double pv = 0;
+        for(size_t i=0; i<k; ++i) for(size_t j=0; j<k; ++j)
+            if(w[i] != 0 && w[j] != 0) pv += w[i] * w[j] * brute(t, i, j);
+        p.check(close_to(cov.portfolio_var(w), pv, 1e-9), cov.portfolio_var(w), pv);
+
+        auto size = vol_target_sizes(cov, signal, 0.10);
+        for(size_t i=0; i<k; ++i) if(!cov.ready(i)) z.check(size[i] == 0);
+    }
+}
+
+int main() {
+    // 40 symbols (more than two 16-wide tiles), 600 bars; symbol 3 starts
+    // at bar 250, symbol 21 misses every 97th bar, symbol 38 stops at 450.
+    const size_t k = 40, bars = 600, W = 60;
+    const double lambda = 0.94;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> N(0, 0.01);
+    Mat R(bars, std::vector<double>(k));
+    for(size_t t=0; t<bars; ++t) {
+        double market = N(rng);
+        for(size_t i=0; i<k; ++i) R[t][i] = 0.5 * market + (1 + i % 5) * N(rng);
+        if(t < 250) R[t][3] = NAN;
+        if(t % 97 == 0) R[t][21] = NAN;
+        if(t >= 450) R[t][38] = NAN;
+    }
+
+    bool ok = true;
+    {
+        RollingCov<double> cov(k, W, 100);
+        Tally c{"rolling cov(i,j)"}, p{"rolling portfolio_var"}, z{"rolling readiness/sizes"};
+        run(cov, R, [&](size_t t, size_t i, size_t j) { return brute_rolling(R, t, W, i, j); },
+            [&](size_t t, size_t i) { return !std::isnan(brute_rolling(R, t, W, i, i)); }, c, p, z);
+        ok = c.print(1e-9) & p.print(1e-9) & z.print(0) && ok;
+    }
+    {
+        EwmaCov<double> cov(k, lambda);
+        size_t warmup = static_cast<size_t>(std::ceil(1 / (1 - lambda)));
+        Tally c{"ewma cov(i,j)"}, p{"ewma portfolio_var"}, z{"ewma readiness/sizes"};
+        run(cov, R, [&](size_t t, size_t i, size_t j) { return brute_ewma(R, t, lambda, i, j); },
+            [&](size_t t, size_t i) {
+                size_t n = 0;
+                for(size_t b=0; b<=t; ++b) n += !std::isnan(R[b][i]);
+                return n >= warmup;
+            }, c, p, z);
+        ok = c.print(1e-9) & p.print(1e-9) & z.print(0) && ok;
+    }
+    std::cout << (ok ? "✓ matches" : "✗ differs from") << " brute-force covariance\n";
+    return ok ? 0 : 2;
+}
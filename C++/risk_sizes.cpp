@@ -0,0 +1,104 @@
+#include "risk.hpp"
+#include "ohlcv.hpp"
+#include "cli.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+
+/* Symbol name from a raw file path: "data/MSFT_1986-...csv" -> "MSFT". */
+static std::string symbol_of(const std::string& path) {
+    size_t s = path.find_last_of("/\\");
+    std::string stem = path.substr(s == std::string::npos ? 0 : s + 1);
+    return stem.substr(0, std::min(stem.find('_'), stem.find('.')));
+}
+
+/* Walks the union of all symbols' dates, feeding close-to-close returns
+   into the covariance estimator bar by bar and writing the vol-targeted
+   size of every symbol for that bar (0 while a symbol has no quote or
+   not yet a full window / EWMA warm-up of real returns).              */
+template<class Cov>
+static int write_sizes(Cov& cov, const std::vector<std::string>& syms,
+                       const std::vector<std::map<std::string, double>>& closes,
+                       const std::string& out, double target, double periods, double max_gross) {
+    std::set<std::string> dates;
+    for(const auto& m : closes) for(const auto& kv : m) dates.insert(kv.first);
+
+    std::ofstream fout(out);
+    if(!fout) { std::cerr << "Cannot write " << out << '\n'; return 1; }
+    fout << "date";
+    for(const auto& s : syms) fout << ',' << s;
+    fout << ",port_vol\n" << std::fixed << std::setprecision(6);
+
+    size_t k = syms.size(), kept = 0;
+    std::vector<double> prev(k, NAN), ret(k), signal(k);
+    for(const auto& d : dates) {
+        for(size_t i=0; i<k; ++i) {
+            auto it = closes[i].find(d);
+            bool quoted = it != closes[i].end();
+            ret[i] = quoted && !std::isnan(prev[i]) ? it->second / prev[i] - 1 : NAN;
+            signal[i] = quoted && !std::isnan(prev[i]) ? 1.0 : 0.0;
+            if(quoted) prev[i] = it->second;
+        }
+        cov.push(ret.data());
+        if(!cov.ready()) continue;
+
+        auto w = vol_target_sizes(cov, signal, target, periods, max_gross);
+        fout << d;
+        for(double x : w) fout << ',' << x;
+        fout << ',' << std::sqrt(periods * std::max(0.0, cov.portfolio_var(w))) << '\n';
+        ++kept;
+    }
+    std::cout << "Symbols     : " << k << "\nBars        : " << dates.size()
+              << "\nSized bars  : " << kept << "\n✓ Position sizes written to " << out << '\n';
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    size_t window = 60;
+    double lambda = 0, target = 0.10, periods = 252, max_gross = 2.0;
+    std::vector<std::string> pos;
+    bool ok = true;
+    for(int i=1; i<argc; ++i) {
+        std::string a = argv[i];
+        if(a == "--window" && i+1 < argc) ok = parse_count(argv[++i], window, size_t(2)) && ok;
+        else if(a == "--ewma" && i+1 < argc) ok = parse_real(argv[++i], lambda) && ok;
+        else if(a == "--target" && i+1 < argc) ok = parse_real(argv[++i], target) && ok;
+        else if(a == "--periods" && i+1 < argc) ok = parse_real(argv[++i], periods) && ok;
+        else if(a == "--max-gross" && i+1 < argc) ok = parse_real(argv[++i], max_gross) && ok;
+        else pos.push_back(a);
+    }
+    if(!ok || pos.size() < 2 || lambda < 0 || lambda >= 1
+       || !(target > 0) || !(periods > 0) || !(max_gross > 0)) {
+        std::cerr << "Usage: risk_sizes.exe [--window W | --ewma LAMBDA] [--target VOL]\n"
+                     "                      [--periods N] [--max-gross G] <out> <raw>...\n"
+                     "  --window     rolling covariance over W bars (default 60)\n"
+                     "  --ewma       EWMA covariance with decay LAMBDA, e.g. 0.94\n"
+                     "  --target     annualised portfolio volatility target (default 0.10)\n"
+                     "  --periods    bars per year (default 252)\n"
+                     "  --max-gross  cap on total absolute exposure (default 2.0)\n";
+        return 1;
+    }
+
+    std::vector<std::string> syms;
+    std::vector<std::map<std::string, double>> closes;
+    for(size_t f=1; f<pos.size(); ++f) {
+        OHLCV<double> d;
+        if(!load_ohlcv(pos[f], d)) { std::cerr << "Cannot open " << pos[f] << '\n'; return 1; }
+        syms.push_back(symbol_of(pos[f]));
+        closes.emplace_back();
+        for(size_t i=0; i<d.size(); ++i) closes.back()[d.date[i]] = d.c[i];
+    }
+
+    if(lambda > 0) {
+        EwmaCov<double> cov(syms.size(), lambda);
+        return write_sizes(cov, syms, closes, pos[0], target, periods, max_gross);
+    }
+    RollingCov<double> cov(syms.size(), window);
+    return write_sizes(cov, syms, closes, pos[0], target, periods, max_gross);
+}
@@ -0,0 +1,181 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+#include "indicators.hpp"
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <limits>
+
+/*────────────────────  Parallel prefix scans  ────────────────────*/
+/* EMA, Wilder smoothing and cumulative sums are all first-order linear
+   recurrences y[i] = a[i]*y[i-1] + b[i]. Affine maps compose associatively,
+   so a series is split into one chunk per thread and scanned in three
+   passes:
+     1. every chunk runs its recurrence from y=0 and records the product
+        of its a's,
+     2. chunk entry values are chained serially (one step per chunk),
+     3. every chunk adds (product of a's so far) * entry value.
+   With 0 <= a <= 1 that product decays geometrically. Once it falls below
+   epsilon the correction no longer changes a value, so it is flushed to 0
+   and passes 1 and 3 stop multiplying. Left alone it would decay into
+   denormals, and would stay stuck at the smallest denormal for a > 0.5,
+   making every later step a slow denormal operation.
+   Results match the sequential indicators within ~1e-12 relative error in
+   double (the correction in pass 3 is a contraction for EMA/Wilder and
+   exact for sums); precision_check reports the measured gap per column.  */
+
+/* want=0 picks the core count and keeps chunks >= 64k points, since below
+   that the thread start-up outweighs the work. An explicit want is capped
+   too, at chunks of >= 4096 points, so a short series never pays for N
+   spawns per pass.                                                       */
+inline unsigned scan_threads(unsigned want,size_t n){
+    size_t cap=n>>12;
+    if(want==0){ want=std::max(1u,std::thread::hardware_concurrency()); cap=n>>16; }
+    return static_cast<unsigned>(std::max<size_t>(1,std::min<size_t>(want,cap)));
+}
+
+/* Splits [begin,end) into `parts` contiguous chunks and runs fn(k,b,e) on each. */
+template<class Fn> inline void for_chunks(size_t begin,size_t end,unsigned parts,Fn fn){
+    size_t n=end-begin;
+    if(parts<=1){ fn(0u,begin,end); return; }
+    std::vector<std::thread> pool;
+    for(unsigned k=0;k<parts;++k){
+        size_t b=begin+n*k/parts, e=begin+n*(k+1)/parts;
+        pool.emplace_back(fn,k,b,e);
+    }
+    for(auto& t:pool) t.join();
+}
+
+/* out[i] = a(i)*out[i-1] + b(i) for i in [begin,end), with out[begin-1]=y0.
+   coef(i,a,b) fills the coefficients of step i, with 0 <= a <= 1.         */
+template<class T,class Coef>
+inline void affine_scan(std::vector<T>& out,size_t begin,size_t end,T y0,
+                        Coef coef,unsigned threads){
+    if(begin>=end) return;
+    unsigned parts=scan_threads(threads,end-begin);
+    if(parts==1){
+        T y=y0, a, c;
+        for(size_t i=begin;i<end;++i){ coef(i,a,c); y=a*y+c; out[i]=y; }
+        return;
+    }
+    std::vector<T> A(parts,T(1)), B(parts,T(0));
+    const T eps=std::numeric_limits<T>::epsilon();
+
+    for_chunks(begin,end,parts,[&](unsigned k,size_t b,size_t e){
+        T y=0, p=1, a, c;
+        size_t i=b;
+        for(;i<e&&p!=0;++i){ coef(i,a,c); y=a*y+c; p*=a; if(p<eps) p=0; out[i]=y; }
+        for(;i<e;++i){ coef(i,a,c); y=a*y+c; out[i]=y; }
+        A[k]=p; B[k]=y;
+    });
+
+    std::vector<T> in(parts);
+    in[0]=y0;
+    for(unsigned k=1;k<parts;++k) in[k]=A[k-1]*in[k-1]+B[k-1];
+
+    for_chunks(begin,end,parts,[&](unsigned k,size_t b,size_t e){
+        T p=1, a, c;
+        for(size_t i=b;i<e;++i){
+            coef(i,a,c); p*=a;
+            if(p<eps) break;                     // rest of the chunk is exact
+            out[i]+=p*in[k];
+        }
+    });
+}
+
+/* EMA (NaN-aware), same semantics as ema_safe */
+template<class T>
+inline std::vector<T> ema_scan(const std::vector<T>& src,int p,unsigned threads=0){
+    size_t n=src.size(); std::vector<T> out(n,nan_v<T>);
+    KSum<T> seed; int cnt=0; size_t s=0;
+    for(;s<n&&cnt<p;++s) if(!is_nan(src[s])){ seed.add(src[s]); ++cnt; }
+    if(cnt<p) return out;
+    out[s-1]=seed.val()/p;
+
+    const T k=T(2)/(p+T(1));
+    affine_scan(out,s,n,out[s-1],[&](size_t i,T& a,T& b){
+        if(is_nan(src[i])){ a=1; b=0; } else { a=1-k; b=k*src[i]; }
+    },threads);
+    return out;
+}
+
+/* RSI with Wilder smoothing, same semantics as rsi() */
+template<class T>
+inline std::vector<T> rsi_scan(const std::vector<T>& c,int p,unsigned threads=0){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
+    if(n<=static_cast<size_t>(p)) return out;
+    T g=0,l=0;
+    for(int i=1;i<=p;++i){
+        T d=c[i]-c[i-1]; (d>=0?g:l)+=std::fabs(d);
+    } g/=p; l/=p; out[p]=T(100)-T(100)/(1+g/l);
+
+    const T w=T(p-1)/p;
+    std::vector<T> G(n), L(n);
+    affine_scan(G,p+1,n,g,[&](size_t i,T& a,T& b){
+        T d=c[i]-c[i-1]; a=w; b=(d>0?d:0)/p;
+    },threads);
+    affine_scan(L,p+1,n,l,[&](size_t i,T& a,T& b){
+        T d=c[i]-c[i-1]; a=w; b=(d<0?-d:0)/p;
+    },threads);
+    for_chunks(p+1,n,scan_threads(threads,n),[&](unsigned,size_t b,size_t e){
+        for(size_t i=b;i<e;++i) out[i]=T(100)-T(100)/(1+G[i]/L[i]);
+    });
+    return out;
+}
+
+/* On-Balance Volume, same semantics as obv(). Each chunk keeps a
+   compensated running sum, so only the chunk offsets are added in pass 2. */
+template<class T>
+inline std::vector<T> obv_scan(const std::vector<T>& c,
+                               const std::vector<T>& v,unsigned threads=0){
+    size_t n=c.size(); std::vector<T> out(n,nan_v<T>);
+    if(n<2) return out;
+    unsigned parts=scan_threads(threads,n-1);
+    std::vector<KSum<T>> tot(parts);
+
+    for_chunks(1,n,parts,[&](unsigned k,size_t b,size_t e){
+        KSum<T> run;
+        for(size_t i=b;i<e;++i){
+            if(is_nan(c[i])||is_nan(c[i-1])) continue;
+            run.add(c[i]>c[i-1]?v[i]:(c[i]<c[i-1]? -v[i]:T(0)));
+            out[i]=run.val();
+        }
+        tot[k]=run;
+    });
+    if(parts==1) return out;
+
+    std::vector<T> off(parts,T(0));
+    KSum<T> acc;
+    for(unsigned k=1;k<parts;++k){ acc.add(tot[k-1].s); acc.add(tot[k-1].c); off[k]=acc.val(); }
+    for_chunks(1,n,parts,[&](unsigned k,size_t b,size_t e){
+        if(k==0) return;
+        for(size_t i=b;i<e;++i) if(!is_nan(out[i])) out[i]+=off[k];
+    });
+    return out;
+}
+
+/* VWMA: the window sums need no carried state beyond `period` bars, so
+   every chunk rebuilds its first window from the bars before it and then
+   slides exactly like vwma().                                            */
+template<class T>
+inline std::vector<T> vwma_scan(const std::vector<T>& prices,
+                                const std::vector<T>& volumes,
+                                int period=20,unsigned threads=0){
+    size_t n=prices.size(); std::vector<T> out(n,nan_v<T>);
+    for_chunks(0,n,scan_threads(threads,n),[&](unsigned,size_t b,size_t e){
+        KSum<T> sum_price, sum_vol; int cnt=0;
+        for(size_t j=b>static_cast<size_t>(period)?b-period:0;j<b;++j)
+            if(!is_nan(prices[j])){ sum_price.add(prices[j]*volumes[j]); sum_vol.add(volumes[j]); ++cnt; }
+        for(size_t i=b;i<e;++i){
+            if(!is_nan(prices[i])){ sum_price.add(prices[i]*volumes[i]); sum_vol.add(volumes[i]); ++cnt; }
+            if(i>=static_cast<size_t>(period)){
+                size_t j=i-period;
+                if(!is_nan(prices[j])){ sum_price.add(-(prices[j]*volumes[j])); sum_vol.add(-volumes[j]); --cnt; }
+            }
+            if(cnt==period&&sum_vol.val()!=0) out[i]=sum_price.val()/sum_vol.val();
+        }
+    });
+    return out;
+}
+
+#endif
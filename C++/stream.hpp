@@ -0,0 +1,283 @@
+#ifndef STREAM_HPP
+#define STREAM_HPP
+#include "features.hpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+/*────────────────────  Incremental indicator state  ────────────────────*/
+/* One push() per bar, carrying exactly the state the batch loops in
+   indicators.hpp carry between iterations, in the same operation order, so
+   a streamed series is bit-identical to the batch one however it is cut.  */
+
+template<class T> struct EmaState{
+    int p; T k; KSum<T> prev; int cnt=0;
+    explicit EmaState(int p):p(p),k(T(2)/(p+T(1))){}
+    T push(T x){
+        if(is_nan(x)) return cnt>=p?prev.val():nan_v<T>;
+        if(cnt<p){
+            prev.add(x);
+            if(++cnt==p){ T seed=prev.val()/p; prev.reset(); prev.add(seed); return seed; }
+            return nan_v<T>;
+        }
+        prev.add(k*(x-prev.val())); return prev.val();
+    }
+};
+
+/* Last p values, oldest first out */
+template<class T> struct Ring{
+    std::vector<T> buf; size_t pos=0, seen=0;
+    explicit Ring(int p):buf(p){}
+    bool full() const {return seen>=buf.size();}
+    T oldest() const {return buf[pos];}
+    void push(T x){ buf[pos]=x; pos=(pos+1)%buf.size(); ++seen; }
+    T max() const {return *std::max_element(buf.begin(),buf.end());}
+    T min() const {return *std::min_element(buf.begin(),buf.end());}
+};
+
+template<class T> struct SmaState{
+    int p; Ring<T> win; KSum<T> sum; int cnt=0;
+    explicit SmaState(int p):p(p),win(p){}
+    T push(T x){
+        if(!is_nan(x)){ sum.add(x); ++cnt; }
+        if(win.full()&&!is_nan(win.oldest())){ sum.add(-win.oldest()); --cnt; }
+        win.push(x);
+        return cnt==p?sum.val()/p:nan_v<T>;
+    }
+};
+
+template<class T> struct SdState{
+    int p; Ring<T> dev; KSum<T> ss; int cnt=0;   // dev = v-ma, NaN if either is
+    explicit SdState(int p):p(p),dev(p){}
+    T push(T v,T ma){
+        T d=(!is_nan(v)&&!is_nan(ma))?v-ma:nan_v<T>;
+        if(!is_nan(d)){ ss.add(d*d); ++cnt; }
+        if(dev.full()&&!is_nan(dev.oldest())){ T o=dev.oldest(); ss.add(-(o*o)); --cnt; }
+        dev.push(d);
+        return cnt==p?std::sqrt(std::max(ss.val(),T(0))/p):nan_v<T>;
+    }
+};
+
+template<class T> struct TrueRangeState{
+    T prev_c=0; bool first=true;
+    T push(T h,T l,T c){
+        T hl=h-l;
+        T hc=first?hl:std::fabs(h-prev_c);
+        T lc=first?hl:std::fabs(l-prev_c);
+        first=false; prev_c=c;
+        return std::max({hl,hc,lc});
+    }
+};
+
+template<class T> struct RsiState{
+    int p; size_t i=0; T prev_c=0, g=0, l=0;
+    explicit RsiState(int p):p(p){}
+    T push(T c){
+        size_t k=i++; T d=c-prev_c; prev_c=c;
+        if(k==0||k<static_cast<size_t>(p)){ if(k) (d>=0?g:l)+=std::fabs(d); return nan_v<T>; }
+        if(k==static_cast<size_t>(p)){ (d>=0?g:l)+=std::fabs(d); g/=p; l/=p; }
+        else{
+            T up=d>0?d:0, dn=d<0?-d:0;
+            g=(g*(p-1)+up)/p; l=(l*(p-1)+dn)/p;
+        }
+        return T(100)-T(100)/(1+g/l);
+    }
+};
+
+template<class T> struct SupertrendState{
+    double mlt; T prev=0; bool first=true;
+    explicit SupertrendState(double mlt):mlt(mlt){}
+    T push(T h,T l,T c,T a){
+        T ai=is_nan(a)?T(0):a;
+        T hl2=T(0.5)*(h+l);
+        T up=hl2+T(mlt)*ai, low=hl2-T(mlt)*ai;
+        prev=first?low:(c>prev)?std::max(low,prev):std::min(up,prev);
+        first=false; return prev;
+    }
+};
+
+template<class T> struct StochKState{
+    Ring<T> hi, lo;
+    explicit StochKState(int klen):hi(klen),lo(klen){}
+    T push(T h,T l,T c){
+        hi.push(h); lo.push(l);
+        if(!hi.full()) return nan_v<T>;
+        T hh=hi.max(), ll=lo.min();
+        return hh==ll?nan_v<T>:T(100)*(c-ll)/(hh-ll);
+    }
+};
+
+template<class T> struct RocState{
+    Ring<T> win;
+    explicit RocState(int p):win(p){}
+    T push(T c){
+        T out=nan_v<T>;
+        if(win.full()){ T o=win.oldest(); if(!is_nan(o)&&o!=0) out=T(100)*(c-o)/o; }
+        win.push(c); return out;
+    }
+};
+
+template<class T> struct ObvState{
+    KSum<T> running; T prev_c=0; bool first=true;
+    T push(T c,T v){
+        T out=nan_v<T>;
+        if(!first&&!is_nan(c)&&!is_nan(prev_c)){
+            running.add(c>prev_c?v:(c<prev_c? -v:T(0)));
+            out=running.val();
+        }
+        first=false; prev_c=c; return out;
+    }
+};
+
+/*────────────────────  Streaming feature set  ────────────────────*/
+/* Same columns as build_feature_graph(), one bar at a time. Only the
+   state behind the selected columns is updated, so --features cuts the work
+   here too. The volume weighting of `rsi` is relative to the whole file's
+   volume range, which must therefore be known up front (see volume_range()). */
+template<class T> class FeatureStream{
+public:
+    FeatureStream(const std::vector<std::string>& names,T vmin,T vrange,
+                  const FeatureParams& P=FeatureParams())
+        :names_(names),bb_k_(P.bb_k),vmin_(vmin),vrange_(vrange),
+         scale_vol_(std::isfinite(vmin)&&std::isfinite(vrange)&&vrange>0),
+         ema_fast_(P.macd_fast),ema_slow_(P.macd_slow),sig_(P.macd_signal),
+         rsi_(P.rsi_period),atr_st_(P.st_period),atr_(P.atr_period),st_(P.st_mult),
+         sma_bb_(P.bb_period),sd_bb_(P.bb_period),stoch_(P.stoch_k),stoch_d_(P.stoch_d),
+         roc_(P.roc_period){
+        const auto& all=feature_names();
+        on_.assign(all.size(),false);
+        for(const auto& n:names){
+            pick_.push_back(std::find(all.begin(),all.end(),n)-all.begin());
+            on_[pick_.back()]=true;
+        }
+        row_.assign(all.size(),nan_v<T>);
+    }
+
+    /* Appends the features of every bar in `in` to `out` (cleared first). */
+    void process(const OHLCV<T>& in,FeatureSet<T>& out){
+        out.names=names_;
+        out.cols.resize(names_.size());
+        for(auto& col:out.cols) col.clear();
+        auto& row=row_;
+        const auto& on=on_;
+        for(size_t i=0;i<in.size();++i){
+            T h=in.h[i], l=in.l[i], c=in.c[i], v=in.v[i];
+            row[0]=c;
+            if(on[1]){
+                T f=ema_fast_.push(c), s=ema_slow_.push(c);
+                T m=(!is_nan(f)&&!is_nan(s))?f-s:nan_v<T>;
+                T sg=sig_.push(m);
+                row[1]=(!is_nan(m)&&!is_nan(sg))?m-sg:nan_v<T>;
+            }
+            if(on[2]){
+                T r=rsi_.push(c);
+                if(scale_vol_&&!is_nan(r)&&!is_nan(v)) r=50+(r-50)*(T(0.8)+T(0.4)*((v-vmin_)/vrange_));
+                row[2]=r;
+            }
+            if(on[3]||on[7]){
+                T tr=tr_.push(h,l,c);
+                if(on[3]){
+                    T st=st_.push(h,l,c,atr_st_.push(tr));
+                    row[3]=is_nan(st)?nan_v<T>:(c>st?T(1):T(0));
+                }
+                if(on[7]){ T a=atr_.push(tr); row[7]=is_nan(a)?nan_v<T>:a/c; }
+            }
+            if(on[4]){
+                T ma=sma_bb_.push(c), sdv=sd_bb_.push(c,ma);
+                row[4]=(!is_nan(ma)&&!is_nan(sdv)&&sdv!=0)?(c-ma)/(T(bb_k_)*sdv)+T(0.5):nan_v<T>;
+            }
+            if(on[5]||on[6]){
+                T k=stoch_.push(h,l,c);
+                row[5]=k;
+                if(on[6]) row[6]=stoch_d_.push(k);
+            }
+            if(on[8]) row[8]=roc_.push(c);
+            if(on[9]) row[9]=obv_.push(c,v);
+            if(on[10]) row[10]=(h+l+c)/3*v;
+
+            for(size_t j=0;j<pick_.size();++j) out.cols[j].push_back(row[pick_[j]]);
+        }
+    }
+
+private:
+    std::vector<std::string> names_;
+    std::vector<size_t> pick_;
+    std::vector<bool> on_;  // column selected, by file order
+    std::vector<T> row_;    // every column of the current bar, file order
+    double bb_k_;
+    T vmin_, vrange_;
+    bool scale_vol_;        // as volume_scale_rsi(): no scaling on an empty/flat range
+    EmaState<T> ema_fast_, ema_slow_, sig_;
+    RsiState<T> rsi_;
+    TrueRangeState<T> tr_;
+    EmaState<T> atr_st_, atr_;
+    SupertrendState<T> st_;
+    SmaState<T> sma_bb_;
+    SdState<T> sd_bb_;
+    StochKState<T> stoch_;
+    EmaState<T> stoch_d_;
+    RocState<T> roc_;
+    ObvState<T> obv_;
+};
+
+/* Pre-pass for the RSI volume weighting, which needs the whole file's
+   volume range before the first bar is streamed. Only the last field of
+   each line is converted; no other column is parsed.                   */
+template<class T> inline bool volume_range(const std::string& path,T& vmin,T& vrange){
+    std::ifstream fin(path);
+    if(!fin) return false;
+    std::string line; T v;
+    std::getline(fin,line); // header
+    T lo=std::numeric_limits<T>::infinity(), hi=-lo;
+    while(std::getline(fin,line)){
+        size_t comma=line.rfind(',');
+        if(comma==std::string::npos||!to_value(line.substr(comma+1),v)) continue;
+        lo=std::min(lo,v); hi=std::max(hi,v);
+    }
+    vmin=lo; vrange=hi-lo;    // non-finite when no row had a volume
+    return true;
+}
+
+/*────────────────────  Double buffer  ────────────────────*/
+/* Two reusable buffers handed back and forth between one producer and one
+   consumer thread: the producer fills one while the consumer drains the
+   other. Buffers are never reallocated, only cleared, so vector capacity
+   is kept from chunk to chunk.                                          */
+template<class B> class DoubleBuffer{
+public:
+    /* Producer: next empty buffer (blocks while both are full). */
+    B& acquire(){
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk,[&]{return !full_[w_];});
+        return buf_[w_];
+    }
+    /* Producer: hand the acquired buffer over; last=true ends the stream. */
+    void publish(bool last=false){
+        { std::lock_guard<std::mutex> lk(m_); full_[w_]=true; last_[w_]=last; w_^=1; }
+        cv_.notify_all();
+    }
+    /* Consumer: next full buffer (blocks while both are empty). */
+    B& next(bool& last){
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk,[&]{return full_[r_];});
+        last=last_[r_];
+        return buf_[r_];
+    }
+    /* Consumer: give the buffer from next() back to the producer. */
+    void release(){
+        { std::lock_guard<std::mutex> lk(m_); full_[r_]=false; r_^=1; }
+        cv_.notify_all();
+    }
+private:
+    B buf_[2];
+    bool full_[2]={false,false}, last_[2]={false,false};
+    int w_=0, r_=0;
+    std::mutex m_;
+    std::condition_variable cv_;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef WINDOW_HPP
+#define WINDOW_HPP
+#include "features.hpp"
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/*────────────────────  Contiguous feature matrix  ────────────────────*/
+/* Row-major rows×cols copy of the exported (complete) rows of a feature
+   set, in the float32 the sequence models consume. Built once; every
+   look-back window is then a view into it.                            */
+template<class T> struct FeatureMatrix{
+    size_t rows=0, cols=0;
+    std::vector<T> data;
+    std::vector<size_t> source_row;     // index of each row in the FeatureSet
+
+    template<class U> static FeatureMatrix from(const FeatureSet<U>& F){
+        FeatureMatrix m; m.cols=F.cols.size();
+        for(size_t i=0;i<F.rows();++i){
+            if(!row_complete(F,i)) continue;
+            for(const auto& col:F.cols) m.data.push_back(static_cast<T>(col[i]));
+            m.source_row.push_back(i);
+        }
+        m.rows=m.source_row.size();
+        return m;
+    }
+    T* row(size_t i){return data.data()+i*cols;}
+    const T* row(size_t i) const {return data.data()+i*cols;}
+};
+
+/*────────────────────  Sliding-window view  ────────────────────*/
+/* The W-row windows of a matrix without copying: window i is the W×F
+   block starting at matrix row start(i), so overlapping windows share the
+   same storage. Only windows whose W rows were consecutive bars of the
+   source series are listed: one across a dropped (incomplete) row would
+   silently join bars that are not adjacent.                           */
+template<class T> struct WindowView{
+    const T* base; size_t rows, F, W, stride;
+    std::vector<size_t> starts;         // first matrix row of each window
+
+    WindowView(const FeatureMatrix<T>& m,size_t W)
+        :base(m.data.data()),rows(m.rows),F(m.cols),W(W),stride(m.cols){
+        for(size_t s=0;W&&s+W<=rows;++s)
+            if(m.source_row[s+W-1]-m.source_row[s]==W-1) starts.push_back(s);
+    }
+
+    size_t size() const {return starts.size();}
+    size_t start(size_t i) const {return starts[i];}
+    size_t offset(size_t i) const {return starts[i]*stride;}
+    const T* window(size_t i) const {return base+offset(i);}   // W rows of F
+};
+
+/*────────────────────  Standard scaler  ────────────────────*/
+/* (x - mean) / scale per feature, as sklearn's StandardScaler. Loaded from
+   a "feature,mean,scale" CSV (python/windows.py: save_scaler_csv) and
+   matched to the exported columns by name.                            */
+template<class T> struct Scaler{
+    std::vector<T> mean, inv_scale;
+
+    bool load(const std::string& path,const std::vector<std::string>& names){
+        std::ifstream fin(path);
+        if(!fin) return false;
+        mean.assign(names.size(),T(0)); inv_scale.assign(names.size(),T(1));
+        std::vector<bool> seen(names.size(),false);
+        std::string line, name, tok;
+        std::getline(fin,line); // header
+        while(std::getline(fin,line)){
+            std::stringstream ss(line); T m, s;
+            if(!std::getline(ss,name,',')) continue;
+            auto it=std::find(names.begin(),names.end(),name);
+            if(it==names.end()) continue;
+            if(!std::getline(ss,tok,',')||!to_value(tok,m)) return false;
+            if(!std::getline(ss,tok,',')||!to_value(tok,s)||s==0) return false;
+            size_t j=it-names.begin();
+            mean[j]=m; inv_scale[j]=T(1)/s; seen[j]=true;
+        }
+        return std::all_of(seen.begin(),seen.end(),[](bool b){return b;});
+    }
+
+    void apply(const T* in,T* out,size_t F) const {
+        for(size_t f=0;f<F;++f) out[f]=(in[f]-mean[f])*inv_scale[f];
+    }
+};
+
+/*────────────────────  Batch generator  ────────────────────*/
+/* Fills one pre-allocated batch×W×F buffer with (optionally scaled)
+   windows, reused for every batch: no allocation after construction.
+   Windows are picked sequentially by next() or by window index with
+   fill(), e.g. from a shuffled index list for training feeds. This is the
+   in-process (C++/ONNX) counterpart of WindowFeed in python/windows.py. */
+template<class T> class WindowBatcher{
+public:
+    WindowBatcher(const WindowView<T>& v,size_t batch,const Scaler<T>* scaler=nullptr)
+        :v_(v),batch_(batch),scaler_(scaler),buf_(batch*v.W*v.F),idx_(batch){}
+
+    size_t batch() const {return batch_;}
+    size_t window_size() const {return v_.W*v_.F;}
+    const T* data() const {return buf_.data();}
+
+    /* Copies windows idx[0..count) into the buffer; returns how many. */
+    size_t fill(const size_t* idx,size_t count){
+        count=std::min(count,batch_);
+        for(size_t b=0;b<count;++b){
+            const T* src=v_.window(idx[b]);
+            T* dst=buf_.data()+b*window_size();
+            if(!scaler_){ std::copy(src,src+window_size(),dst); continue; }
+            for(size_t r=0;r<v_.W;++r) scaler_->apply(src+r*v_.stride,dst+r*v_.F,v_.F);
+        }
+        return count;
+    }
+
+    /* Next batch in order; 0 once every window has been served. */
+    size_t next(){
+        size_t count=std::min(batch_,v_.size()-std::min(cursor_,v_.size()));
+        for(size_t b=0;b<count;++b) idx_[b]=cursor_+b;
+        cursor_+=count;
+        return fill(idx_.data(),count);
+    }
+    void reset(){cursor_=0;}
+
+private:
+    const WindowView<T>& v_;    // must outlive the batcher
+    size_t batch_, cursor_=0;
+    const Scaler<T>* scaler_;
+    std::vector<T> buf_;
+    std::vector<size_t> idx_;
+};
+
+/*────────────────────  .npy output  ────────────────────*/
+template<class T> inline const char* npy_descr();
+template<> inline const char* npy_descr<float>()  {return "<f4";}
+template<> inline const char* npy_descr<double>() {return "<f8";}
+template<> inline const char* npy_descr<int64_t>(){return "<i8";}
+
+/* NumPy format 1.0, C order, little-endian host assumed. */
+template<class T> inline bool write_npy(const std::string& path,const T* data,
+                                        const std::vector<size_t>& shape){
+    std::string dims;
+    for(size_t d:shape) dims+=std::to_string(d)+",";
+    if(shape.size()>1) dims.pop_back();
+    std::string hdr=std::string("{'descr': '")+npy_descr<T>()+"', 'fortran_order': False, 'shape': ("+dims+"), }";
+    hdr.append(63-(10+hdr.size())%64,' ');
+    hdr+='\n';                                   // magic+len+header is a multiple of 64
+
+    std::ofstream f(path,std::ios::binary);
+    if(!f) return false;
+    uint16_t len=static_cast<uint16_t>(hdr.size());
+    f.write("\x93NUMPY\x01\x00",8);
+    f.write(reinterpret_cast<const char*>(&len),2);
+    f.write(hdr.data(),hdr.size());
+    size_t n=1; for(size_t d:shape) n*=d;
+    f.write(reinterpret_cast<const char*>(data),n*sizeof(T));
+    return static_cast<bool>(f);
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "window.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+/* Checks WindowView and WindowBatcher against brute-force copies on a
+   synthetic feature set with incomplete rows mid-series: only windows of
+   consecutive source rows are listed, each batch holds exactly the
+   (scaled) rows of its windows, the buffer is never reallocated, and
+   sequential and shuffled feeds serve every window once.              */
+
+static bool line(const char* what, bool ok) {
+    std::cout << (ok ? "✓ " : "✗ ") << what << '\n';
+    return ok;
+}
+
+int main() {
+    const size_t n = 300, F = 4, W = 12, B = 16;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> N(0, 1);
+    FeatureSet<double> fs;
+    fs.names = {"a", "b", "c", "d"};
+    fs.cols.assign(F, std::vector<double>(n));
+    for(auto& col : fs.cols) for(auto& x : col) x = N(rng);
+    for(size_t i : {0, 1, 2, 50, 120, 121, 122, 200, 211}) fs.cols[i % F][i] = NaN;
+
+    auto M = FeatureMatrix<float>::from(fs);
+    WindowView<float> v(M, W);
+
+    // Brute force: every run of W complete source rows in a row
+    std::vector<std::vector<size_t>> want;
+    for(size_t s=0; s+W<=n; ++s) {
+        bool all = true;
+        for(size_t i=s; i<s+W; ++i) all = all && row_complete(fs, i);
+        if(all) { want.emplace_back(); for(size_t i=s; i<s+W; ++i) want.back().push_back(i); }
+    }
+    bool ok = line("windows are exactly the runs of W complete rows", v.size() == want.size());
+    for(size_t k=0; ok && k<v.size(); ++k)
+        for(size_t r=0; r<W; ++r)
+            if(M.source_row[v.start(k) + r] != want[k][r]) ok = false;
+    ok = line("every window maps to consecutive source rows", ok) && ok;
+
+    Scaler<float> sc;
+    sc.mean = {0.5f, -1.0f, 2.0f, 0.0f};
+    sc.inv_scale = {2.0f, 0.5f, 1.0f, 4.0f};
+    auto expect = [&](size_t k, size_t r, size_t f) {
+        return (static_cast<float>(fs.cols[f][want[k][r]]) - sc.mean[f]) * sc.inv_scale[f];
+    };
+    auto same_batch = [&](const WindowBatcher<float>& wb, const size_t* idx, size_t count) {
+        for(size_t b=0; b<count; ++b)
+            for(size_t r=0; r<W; ++r)
+                for(size_t f=0; f<F; ++f)
+                    if(wb.data()[(b*W + r)*F + f] != expect(idx[b], r, f)) return false;
+        return true;
+    };
+
+    WindowBatcher<float> wb(v, B, &sc);
+    const float* buf = wb.data();
+    size_t served = 0, batches = 0, got;
+    bool rows_ok = true, sizes_ok = true;
+    std::vector<size_t> idx(B);
+    while((got = wb.next())) {
+        for(size_t b=0; b<got; ++b) idx[b] = served + b;
+        rows_ok = rows_ok && same_batch(wb, idx.data(), got);
+        sizes_ok = sizes_ok && (got == B || served + got == v.size());
+        served += got; ++batches;
+    }
+    ok = line("sequential batches hold the scaled window rows", rows_ok) && ok;
+    ok = line("full batches then one partial, every window once",
+              sizes_ok && served == v.size() && batches == (v.size() + B - 1) / B) && ok;
+    ok = line("next() stays 0 after the last window", wb.next() == 0) && ok;
+
+    std::vector<size_t> order(v.size());
+    for(size_t k=0; k<order.size(); ++k) order[k] = k;
+    std::shuffle(order.begin(), order.end(), rng);
+    rows_ok = true;
+    for(size_t s=0; s<order.size(); s+=B) {
+        size_t count = wb.fill(order.data() + s, std::min(B, order.size() - s));
+        rows_ok = rows_ok && same_batch(wb, order.data() + s, count);
+    }
+    ok = line("shuffled fill() batches hold the scaled window rows", rows_ok) && ok;
+
+    wb.reset();
+    got = wb.next();
+    idx.assign(B, 0);
+    for(size_t b=0; b<got; ++b) idx[b] = b;
+    ok = line("reset() restarts from the first window", got == B && same_batch(wb, idx.data(), got)) && ok;
+    ok = line("one buffer reused for every batch", wb.data() == buf) && ok;
+
+    WindowBatcher<float> raw(v, B);
+    raw.next();
+    bool copy_ok = true;
+    for(size_t b=0; b<B; ++b)
+        for(size_t r=0; r<W; ++r)
+            for(size_t f=0; f<F; ++f)
+                copy_ok = copy_ok && raw.data()[(b*W + r)*F + f] == static_cast<float>(fs.cols[f][want[b][r]]);
+    ok = line("unscaled batches are plain copies", copy_ok) && ok;
+
+    return ok ? 0 : 2;
+}
@@ -1,3 +1,4 @@
+import os
 import pandas as pd
 import numpy as np
 
@@ -7,18 +8,32 @@ def load_test_data(features_path='../data/features.csv', test_start_date='2020-0
     df = df[df['date'] >= test_start_date].reset_index(drop=True)
     return df
 
-# Simulate trades for a given strategy and compute metrics
-def evaluate_strategy(df, buy_signals, sell_signals, transaction_cost=0.001):
+# Load per-bar volatility-targeted position sizes written by C++/risk_sizes,
+# aligned to df's dates (None if the file is missing or lacks the symbol)
+def load_position_sizes(df, sizes_path='../data/position_sizes.csv', symbol='MSFT'):
+    if not os.path.exists(sizes_path):
+        return None
+    sizes = pd.read_csv(sizes_path, parse_dates=['date'])
+    if symbol not in sizes.columns:
+        return None
+    aligned = df[['date']].merge(sizes[['date', symbol]], on='date', how='left')
+    return aligned[symbol].fillna(0.0).values
+
+# Simulate trades for a given strategy and compute metrics.
+# With sizes, each trade's net return is scaled by the size held at entry.
+def evaluate_strategy(df, buy_signals, sell_signals, transaction_cost=0.001, sizes=None):
     trades = []
     position = None
     for i in range(len(df)):
         if buy_signals[i] and position is None:
-            position = df['close'][i]
+            position = i
         elif sell_signals[i] and position is not None:
-            entry = position
+            entry = df['close'][position]
             exit_price = df['close'][i]
             gross_return = (exit_price - entry) / entry
             net_return = gross_return - 2 * transaction_cost  # Buy and sell costs
+            if sizes is not None:
+                net_return *= sizes[position]
             trades.append(net_return)
             position = None
     if not trades:
@@ -33,7 +48,7 @@ def evaluate_strategy(df, buy_signals, sell_signals, transaction_cost=0.001):
     }
 
 # Evaluate and print individual strategies one by one
-def evaluate_individual_strategies(df):
+def evaluate_individual_strategies(df, sizes=None):
     # List of strategies with their buy/sell conditions
     strategy_conditions = {
         'MACD': {
@@ -58,6 +73,12 @@ def evaluate_individual_strategies(df):
     for strat, conditions in strategy_conditions.items():
         metrics = evaluate_strategy(df, conditions['buy'], conditions['sell'])
         print(f"{strat}: Trades={metrics['num_trades']}, Success Rate={metrics['success_rate']:.2f}%, Per-Trade Return={metrics['per_trade_return']:.2f}%")
+    if sizes is None:
+        return
+    print("\nVolatility-Targeted Sizing (Testing Data Only):")
+    for strat, conditions in strategy_conditions.items():
+        metrics = evaluate_strategy(df, conditions['buy'], conditions['sell'], sizes=sizes)
+        print(f"{strat}: Trades={metrics['num_trades']}, Success Rate={metrics['success_rate']:.2f}%, Per-Trade Return={metrics['per_trade_return']:.2f}%")
 
 # Evaluate combined NN strategy
 def evaluate_combined_strategy(nn_predictions_path='nn_predictions.csv'):
@@ -76,7 +97,7 @@ def evaluate_combined_strategy(nn_predictions_path='nn_predictions.csv'):
 # Main function to generate report in sequence
 def generate_report():
     df = load_test_data()
-    evaluate_individual_strategies(df)  # First, individuals
+    evaluate_individual_strategies(df, load_position_sizes(df))  # First, individuals
     combined_metrics = evaluate_combined_strategy()
     print("\nCombined Neural Network Strategy Performance (Testing Data Only):")
     print(f"Trades={combined_metrics['num_trades']}, Success Rate={combined_metrics['success_rate']:.2f}%, Per-Trade Return={combined_metrics['per_trade_return']:.2f}%")
@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+"""
+Zero-copy look-back windows for the sequence models
+────────────────────────────────────────────────────
+• export_features --windows W writes <stem>.X.npy (float32 N×F matrix,
+  row i = features.csv data row i) and <stem>.win.npy (K×2 row ranges of
+  the windows whose rows are consecutive bars)
+• load_windows() memory-maps the matrix and returns a strided view of
+  every W-row window plus the starts of the valid ones: no feature row is
+  duplicated W times
+• WindowFeed serves fixed-size batches of those windows, scaled on the
+  fly, in one reusable buffer (the Python side of the C++ WindowBatcher)
+• save_scaler_csv() dumps a fitted StandardScaler for --scaler / the C++
+  WindowBatcher
+"""
+
+import numpy as np
+import pandas as pd
+from numpy.lib.stride_tricks import sliding_window_view
+
+
+def load_windows(stem: str):
+    """Return (windows, starts): windows is the (N-W+1, W, F) view with
+    windows[s] = X[s:s+W], starts the s of every window whose rows are
+    consecutive bars (a dropped incomplete row splits the series), so
+    windows[starts[k]] is the k-th usable window."""
+    X = np.load(f"{stem}.X.npy", mmap_mode="r")
+    ranges = np.load(f"{stem}.win.npy")
+    if len(ranges) == 0:
+        return np.empty((0, 0, X.shape[1]), dtype=X.dtype), ranges[:, 0]
+    W = int(ranges[0, 1] - ranges[0, 0])
+    windows = sliding_window_view(X, (W, X.shape[1]))[:, 0]   # view, no copy
+    return windows, ranges[:, 0]
+
+
+class WindowFeed:
+    """Batches of windows[starts] for model.predict / train_on_batch.
+
+    Every batch is gathered into the same pre-allocated float32
+    (batch, W, F) buffer and standardized in place with `scaler` (a fitted
+    StandardScaler; leave it None if the export already used --scaler).
+    The array yielded is overwritten by the next batch: copy it if it must
+    outlive the step. The last batch may be shorter.
+    """
+
+    def __init__(self, windows, starts, batch=256, scaler=None, shuffle=False, seed=None):
+        self.windows = windows
+        self.starts = np.asarray(starts, dtype=np.int64)
+        self.batch = batch
+        self.shuffle = shuffle
+        self.rng = np.random.default_rng(seed)
+        self.buf = np.empty((batch,) + windows.shape[1:], dtype=np.float32)
+        self.mean = self.inv_scale = None
+        if scaler is not None:
+            self.mean = np.asarray(scaler.mean_, dtype=np.float32)
+            self.inv_scale = (1.0 / np.asarray(scaler.scale_)).astype(np.float32)
+
+    def __len__(self):
+        return -(-len(self.starts) // self.batch)
+
+    def __iter__(self):
+        order = self.rng.permutation(self.starts) if self.shuffle else self.starts
+        for b in range(0, len(order), self.batch):
+            idx = order[b:b + self.batch]
+            out = self.buf[:len(idx)]
+            np.take(self.windows, idx, axis=0, out=out)
+            if self.mean is not None:
+                out -= self.mean
+                out *= self.inv_scale
+            yield out
+
+
+def save_scaler_csv(scaler, features, path):
+    """feature,mean,scale rows for a fitted sklearn StandardScaler."""
+    pd.DataFrame({"feature": features,
+                  "mean": scaler.mean_,
+                  "scale": scaler.scale_}).to_csv(path, index=False)
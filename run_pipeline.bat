@@ -4,11 +4,12 @@ set PROJ=C:\Users\apoor\Desktop\SOS Trade Smarter
 
 :: ---- 1  Build & export features ----
 cd "%PROJ%\C++"
-if not exist export_features.exe (
-    echo Building C++ exporter…
-    mingw32-make.exe                         || goto :err
-)
-export_features.exe "%PROJ%\data\MSFT_1986-03-13_2025-04-06.csv" ^
+:: make only rebuilds what changed since the last run
+echo Building C++ exporter…
+mingw32-make.exe                             || goto :err
+:: unchanged data and parameters are served from the column cache
+export_features.exe --cache "%PROJ%\data\.feature_cache" ^
+                     "%PROJ%\data\MSFT_1986-03-13_2025-04-06.csv" ^
                      "%PROJ%\data\features.csv"                    || goto :err
 
 :: ---- 2  Activate venv (create if missing) ----